@@ -1,4 +1,4 @@
-QT       += core gui
+QT       += core gui concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -15,12 +15,31 @@ SOURCES += \
     main.cpp \
     mainHomeScreen.cpp \
     mainwindow.cpp \
+    minefield.cpp \
     minesweeper.cpp \
+    mineview.cpp \
     snake.cpp \
+    sudokubatch.cpp \
     sudokuboard.cpp \
+    sudokucandidates.cpp \
     sudokucontroller.cpp \
+    sudokudlx.cpp \
+    sudokuengine.cpp \
     sudokugame.cpp \
-    sudokusolver.cpp
+    sudokugenerator.cpp \
+    sudokuhint.cpp \
+    sudokuhistory.cpp \
+    sudokulibrary.cpp \
+    sudokulogic.cpp \
+    sudokumodel.cpp \
+    sudokuplayback.cpp \
+    sudokupuzzlepool.cpp \
+    sudokurater.cpp \
+    sudokusession.cpp \
+    sudokusolver.cpp \
+    sudokuunits.cpp \
+    sudokuvariantengine.cpp \
+    sudokuvariants.cpp
 
 HEADERS += \
     basegamescreen.h \
@@ -31,12 +50,31 @@ HEADERS += \
     homescreen.h \
     mainHomeScreen.h \
     mainwindow.h \
+    minefield.h \
     minesweeper.h \
+    mineview.h \
     snake.h \
+    sudokubatch.h \
     sudokuboard.h \
+    sudokucandidates.h \
     sudokucontroller.h \
+    sudokudlx.h \
+    sudokuengine.h \
     sudokugame.h \
-    sudokusolver.h
+    sudokugenerator.h \
+    sudokuhint.h \
+    sudokuhistory.h \
+    sudokulibrary.h \
+    sudokulogic.h \
+    sudokumodel.h \
+    sudokuplayback.h \
+    sudokupuzzlepool.h \
+    sudokurater.h \
+    sudokusession.h \
+    sudokusolver.h \
+    sudokuunits.h \
+    sudokuvariantengine.h \
+    sudokuvariants.h
 
 FORMS += \
     gamescreen.ui \
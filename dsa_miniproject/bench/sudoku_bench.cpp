@@ -0,0 +1,314 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <algorithm>
+#include <vector>
+#include "sudokucandidates.h"
+#include "sudokudlx.h"
+#include "sudokuengine.h"
+#include "sudokuvariantengine.h"
+#include "sudokuvariants.h"
+
+// Console benchmark for the Sudoku solver backends. Each corpus file holds
+// one 81-character puzzle per line, optionally followed by variant rules in
+// the SudokuVariants text form; every puzzle is solved a few times per
+// backend and the fastest run is kept, so the numbers track the solver
+// rather than scheduler noise.
+
+namespace {
+
+struct Corpus {
+    QString name;
+    std::vector<SudokuEngine::Grid> puzzles;
+    std::vector<SudokuUnits> rules;   // one per puzzle
+    bool variant = false;             // some puzzle is not classic
+};
+
+struct Sample {
+    qint64 ns;
+    uint64_t nodes;
+    uint64_t backtracks;
+    bool solved;
+};
+
+struct Run {
+    QString corpus;
+    QString backend;
+    std::vector<Sample> samples;   // one per puzzle, in file order
+};
+
+struct Summary {
+    double mean, p50, p90, p99, max;   // microseconds
+    bool hasP90, hasP99;               // false when too few samples to tell from max
+    uint64_t nodes, backtracks;
+    int solved;
+};
+
+// Accepts digits with 0 or '.' for empty cells; whatever follows the 81 cells
+// is the rules text, empty for a classic puzzle
+bool parsePuzzle(const QString &line, SudokuEngine::Grid &grid, SudokuUnits &units)
+{
+    int cell = 0, i = 0;
+    for (; i < line.size() && cell < SudokuEngine::CellCount; ++i) {
+        QChar ch = line[i];
+        if (ch.isSpace()) continue;
+        if (ch == '.' || ch == '0') grid[cell++] = 0;
+        else if (ch >= '1' && ch <= '9') grid[cell++] = ch.digitValue();
+        else return false;
+    }
+    return cell == SudokuEngine::CellCount
+        && SudokuVariants::parseRules(line.mid(i).toStdString(), units);
+}
+
+bool loadCorpus(const QString &path, Corpus &corpus, QTextStream &err)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        err << "Cannot open " << path << "\n";
+        return false;
+    }
+    corpus.name = QFileInfo(path).completeBaseName();
+    QTextStream in(&file);
+    int lineNumber = 0;
+    while (!in.atEnd()) {
+        QString line = in.readLine().trimmed();
+        ++lineNumber;
+        if (line.isEmpty() || line.startsWith('#')) continue;
+        SudokuEngine::Grid grid;
+        SudokuUnits units(3);
+        if (parsePuzzle(line, grid, units)) {
+            corpus.puzzles.push_back(grid);
+            corpus.variant |= SudokuVariants::rulesOf(units) != SudokuVariants::Rules::Classic;
+            corpus.rules.push_back(std::move(units));
+        } else {
+            err << path << ":" << lineNumber << ": not a puzzle, skipped\n";
+        }
+    }
+    return true;
+}
+
+template <typename Solver>
+Run measure(const Corpus &corpus, const QString &backend, int repeat)
+{
+    Run run;
+    run.corpus = corpus.name;
+    run.backend = backend;
+    Solver solver;
+    QElapsedTimer clock;
+    for (size_t p = 0; p < corpus.puzzles.size(); ++p) {
+        Sample best = {0, 0, 0, false};
+        for (int i = 0; i < repeat; ++i) {
+            clock.start();
+            bool solved = solver.run(corpus, p);
+            qint64 ns = clock.nsecsElapsed();
+            if (i == 0 || ns < best.ns)
+                best = {ns, solver.stats().nodes, solver.stats().backtracks, solved};
+        }
+        run.samples.push_back(best);
+    }
+    return run;
+}
+
+struct PropagationBackend {
+    SudokuEngine engine;
+    bool run(const Corpus &corpus, size_t p)
+    {
+        engine.load(corpus.puzzles[p]);
+        return engine.solve() == SudokuEngine::Status::Solved;
+    }
+    const SudokuEngine::Stats &stats() const { return engine.stats(); }
+};
+
+struct DancingLinksBackend {
+    SudokuDlx dlx;
+    SudokuEngine::Grid solution;
+    bool run(const Corpus &corpus, size_t p) { return dlx.solve(corpus.puzzles[p], solution); }
+    const SudokuEngine::Stats &stats() const { return dlx.stats(); }
+};
+
+// Each puzzle under its own rules through the generic unit tables; on a
+// classic corpus this keeps the variant engine honest against the others
+struct UnitsBackend {
+    SudokuVariantEngine engine;
+    std::vector<uint8_t> givens;
+    bool run(const Corpus &corpus, size_t p)
+    {
+        givens.assign(corpus.puzzles[p].begin(), corpus.puzzles[p].end());
+        engine.load(corpus.rules[p], givens);
+        return engine.solve() == SudokuVariantEngine::Status::Solved;
+    }
+    const SudokuEngine::Stats &stats() const { return engine.stats(); }
+};
+
+// Nearest-rank percentile of an ascending list
+double percentile(const std::vector<qint64> &sorted, double p)
+{
+    if (sorted.empty()) return 0;
+    size_t rank = static_cast<size_t>(p / 100.0 * sorted.size() + 0.999999);
+    return sorted[qBound<size_t>(1, rank, sorted.size()) - 1] / 1000.0;
+}
+
+// A tail percentile is only worth reporting with enough samples above it;
+// otherwise it is just the slowest puzzle again
+bool meaningful(size_t count, double p)
+{
+    return count * (100.0 - p) / 100.0 >= 10;
+}
+
+Summary summarize(const Run &run)
+{
+    Summary s = {0, 0, 0, 0, 0, false, false, 0, 0, 0};
+    std::vector<qint64> times;
+    for (const Sample &sample : run.samples) {
+        times.push_back(sample.ns);
+        s.mean += sample.ns / 1000.0;
+        s.nodes += sample.nodes;
+        s.backtracks += sample.backtracks;
+        s.solved += sample.solved;
+    }
+    if (times.empty()) return s;
+    std::sort(times.begin(), times.end());
+    s.mean /= times.size();
+    s.p50 = percentile(times, 50);
+    s.p90 = percentile(times, 90);
+    s.p99 = percentile(times, 99);
+    s.hasP90 = meaningful(times.size(), 90);
+    s.hasP99 = meaningful(times.size(), 99);
+    s.max = times.back() / 1000.0;
+    return s;
+}
+
+bool writeCsv(const QString &path, const std::vector<Run> &runs)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) return false;
+    QTextStream out(&file);
+    out << "corpus,backend,puzzle,solved,time_us,nodes,backtracks\n";
+    for (const Run &run : runs) {
+        for (size_t i = 0; i < run.samples.size(); ++i) {
+            const Sample &sample = run.samples[i];
+            out << run.corpus << ',' << run.backend << ',' << i << ',' << int(sample.solved) << ','
+                << QString::number(sample.ns / 1000.0, 'f', 3) << ',' << sample.nodes << ','
+                << sample.backtracks << '\n';
+        }
+    }
+    return true;
+}
+
+bool writeJson(const QString &path, const std::vector<Run> &runs)
+{
+    QJsonArray array;
+    for (const Run &run : runs) {
+        Summary s = summarize(run);
+        QJsonArray samples;
+        for (const Sample &sample : run.samples) {
+            samples.append(QJsonObject{
+                {"solved", sample.solved},
+                {"timeUs", sample.ns / 1000.0},
+                {"nodes", double(sample.nodes)},
+                {"backtracks", double(sample.backtracks)},
+            });
+        }
+        array.append(QJsonObject{
+            {"corpus", run.corpus},
+            {"backend", run.backend},
+            {"puzzles", int(run.samples.size())},
+            {"solved", s.solved},
+            {"meanUs", s.mean},
+            {"p50Us", s.p50},
+            {"p90Us", s.hasP90 ? QJsonValue(s.p90) : QJsonValue()},
+            {"p99Us", s.hasP99 ? QJsonValue(s.p99) : QJsonValue()},
+            {"maxUs", s.max},
+            {"nodes", double(s.nodes)},
+            {"backtracks", double(s.backtracks)},
+            {"samples", samples},
+        });
+    }
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+    file.write(QJsonDocument(QJsonObject{{"runs", array}}).toJson());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("sudoku_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Times the Sudoku solver backends on puzzle corpora.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("corpus", "Puzzle files, one puzzle per line. Defaults to the bundled 17-clue, hardest, generated-hard and variants lists.", "[corpus...]");
+    QCommandLineOption backendOption({"b", "backend"}, "Backend to time: propagation, dlx, units or all. Variant corpora run on units only.", "name", "all");
+    QCommandLineOption repeatOption({"r", "repeat"}, "Solve each puzzle N times and keep the fastest.", "N", "5");
+    QCommandLineOption csvOption("csv", "Write per-puzzle results as CSV.", "file");
+    QCommandLineOption jsonOption("json", "Write summaries and per-puzzle results as JSON.", "file");
+    parser.addOptions({backendOption, repeatOption, csvOption, jsonOption});
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QStringList paths = parser.positionalArguments();
+    if (paths.isEmpty())
+        paths << SUDOKU_BENCH_CORPORA "/17clue.txt" << SUDOKU_BENCH_CORPORA "/hardest.txt"
+              << SUDOKU_BENCH_CORPORA "/generated-hard.txt" << SUDOKU_BENCH_CORPORA "/variants.txt";
+    QString backend = parser.value(backendOption);
+    if (backend != "all" && backend != "propagation" && backend != "dlx" && backend != "units") {
+        err << "Unknown backend " << backend << "\n";
+        return 1;
+    }
+    int repeat = qMax(1, parser.value(repeatOption).toInt());
+
+    std::vector<Run> runs;
+    for (const QString &path : std::as_const(paths)) {
+        Corpus corpus;
+        if (!loadCorpus(path, corpus, err)) return 1;
+        // The classic backends know only rows, columns and boxes
+        if (corpus.variant && backend != "all" && backend != "units") {
+            err << corpus.name << ": variant puzzles need --backend units, skipped\n";
+            continue;
+        }
+        if (!corpus.variant && (backend == "all" || backend == "propagation"))
+            runs.push_back(measure<PropagationBackend>(corpus, "propagation", repeat));
+        if (!corpus.variant && (backend == "all" || backend == "dlx"))
+            runs.push_back(measure<DancingLinksBackend>(corpus, "dlx", repeat));
+        if (backend == "all" || backend == "units")
+            runs.push_back(measure<UnitsBackend>(corpus, "units", repeat));
+    }
+
+    out << "Candidate kernel: " << SudokuCandidates::kernelName(SudokuCandidates::kernel()) << "\n";
+    out << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9\n")
+               .arg("corpus", -16).arg("backend", -12).arg("solved", 9)
+               .arg("mean us", 10).arg("p50 us", 10).arg("p90 us", 10).arg("p99 us", 10)
+               .arg("nodes", 12).arg("backtracks", 12);
+    for (const Run &run : runs) {
+        Summary s = summarize(run);
+        // "-" where the corpus is too small for the percentile (see meaningful())
+        QString p90 = s.hasP90 ? QString::number(s.p90, 'f', 1) : "-";
+        QString p99 = s.hasP99 ? QString::number(s.p99, 'f', 1) : "-";
+        out << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9\n")
+                   .arg(run.corpus, -16).arg(run.backend, -12)
+                   .arg(QString("%1/%2").arg(s.solved).arg(run.samples.size()), 9)
+                   .arg(s.mean, 10, 'f', 1).arg(s.p50, 10, 'f', 1).arg(p90, 10)
+                   .arg(p99, 10).arg(s.nodes, 12).arg(s.backtracks, 12);
+    }
+
+    if (parser.isSet(csvOption) && !writeCsv(parser.value(csvOption), runs)) {
+        err << "Cannot write " << parser.value(csvOption) << "\n";
+        return 1;
+    }
+    if (parser.isSet(jsonOption) && !writeJson(parser.value(jsonOption), runs)) {
+        err << "Cannot write " << parser.value(jsonOption) << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,33 @@
+QT       = core
+CONFIG  += console c++17
+CONFIG  -= app_bundle
+
+TARGET = sudoku_bench
+TEMPLATE = app
+
+# Solver sources are shared with the game, no widgets needed
+INCLUDEPATH += ..
+DEFINES += SUDOKU_BENCH_CORPORA=\\\"$$PWD/corpora\\\"
+
+SOURCES += \
+    sudoku_bench.cpp \
+    ../sudokucandidates.cpp \
+    ../sudokudlx.cpp \
+    ../sudokuengine.cpp \
+    ../sudokugenerator.cpp \
+    ../sudokulogic.cpp \
+    ../sudokurater.cpp \
+    ../sudokuunits.cpp \
+    ../sudokuvariantengine.cpp \
+    ../sudokuvariants.cpp
+
+HEADERS += \
+    ../sudokucandidates.h \
+    ../sudokudlx.h \
+    ../sudokuengine.h \
+    ../sudokugenerator.h \
+    ../sudokulogic.h \
+    ../sudokurater.h \
+    ../sudokuunits.h \
+    ../sudokuvariantengine.h \
+    ../sudokuvariants.h
@@ -0,0 +1,9 @@
+# Builds the game and the console solver benchmark together
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    game \
+    bench
+
+game.file = SudokuGame.pro
+bench.file = bench/sudoku_bench.pro
@@ -1,6 +1,11 @@
 #include "gamescreen.h"
 #include "sudokuboard.h"
+#include "sudokuhint.h"
+#include "sudokumodel.h"
 #include "sudokusolver.h"
+#include "sudokuplayback.h"
+#include "sudokugenerator.h"
+#include "sudokupuzzlepool.h"
 #include <QLabel>
 #include <QPushButton>
 #include <QVBoxLayout>
@@ -11,562 +16,52 @@
 #include <QRandomGenerator>
 #include <QApplication>
 #include <QResizeEvent>
+#include <QtConcurrent>
 
-// Predefined puzzles (same as before)
-static const QVector<QVector<QVector<int>>> easyPuzzles = {
-    { // Puzzle 1
-        {5,3,0,0,7,0,0,0,0},
-        {6,0,0,1,9,5,0,0,0},
-        {0,9,8,0,0,0,0,6,0},
-        {8,0,0,0,6,0,0,0,3},
-        {4,0,0,8,0,3,0,0,1},
-        {7,0,0,0,2,0,0,0,6},
-        {0,6,0,0,0,0,2,8,0},
-        {0,0,0,4,1,9,0,0,5},
-        {0,0,0,0,8,0,0,7,9}
-    },
-    { // Puzzle 2
-        {0,0,0,2,0,0,0,6,3},
-        {3,0,0,0,0,5,4,0,1},
-        {0,0,1,0,0,3,9,8,0},
-        {0,0,0,0,9,0,0,2,0},
-        {0,5,0,1,0,2,0,9,0},
-        {0,2,0,0,7,0,0,0,0},
-        {0,8,5,3,0,0,6,0,0},
-        {9,0,3,6,0,0,0,0,7},
-        {6,1,0,0,0,9,0,0,0}
-    },
-
-    { // Puzzle 3
-        {1,0,0,4,8,9,0,0,6},
-        {7,3,0,0,0,0,0,4,0},
-        {0,0,0,0,0,1,2,9,5},
-        {0,0,7,1,2,0,6,0,0},
-        {5,0,0,7,0,3,0,0,8},
-        {0,0,6,0,9,5,7,0,0},
-        {9,1,4,6,0,0,0,0,0},
-        {0,2,0,0,0,0,0,3,7},
-        {8,0,0,5,1,2,0,0,4}
-    },
-
-    { // Puzzle 4
-        {0,2,0,6,0,8,0,0,0},
-        {5,8,0,0,0,9,7,0,0},
-        {0,0,0,0,4,0,0,1,0},
-        {3,7,0,2,0,0,0,6,0},
-        {0,0,0,0,9,0,0,0,0},
-        {0,5,0,0,0,3,0,9,2},
-        {0,9,0,0,1,0,0,0,0},
-        {0,0,2,8,0,0,0,7,5},
-        {0,0,0,9,0,4,0,3,0}
-    },
-
-    { // Puzzle 5
-        {0,0,6,0,0,0,0,0,2},
-        {0,0,0,3,0,5,0,0,0},
-        {0,9,0,0,0,0,4,0,0},
-        {8,0,0,0,0,0,0,0,0},
-        {0,0,0,7,0,1,0,0,0},
-        {0,0,0,0,0,0,0,0,9},
-        {0,0,1,0,0,0,0,6,0},
-        {0,0,0,2,0,8,0,0,0},
-        {6,0,0,0,0,0,3,0,0}
-    },
-
-    { // Puzzle 6
-        {2,0,0,0,0,0,0,0,9},
-        {0,0,0,6,0,0,0,0,0},
-        {0,7,4,0,8,0,0,0,0},
-        {0,0,0,0,0,3,0,0,2},
-        {0,8,0,0,4,0,0,1,0},
-        {6,0,0,5,0,0,0,0,0},
-        {0,0,0,0,1,0,7,8,0},
-        {0,0,0,0,0,6,0,0,0},
-        {1,0,0,0,0,0,0,0,5}
-    },
-
-    { // Puzzle 7
-        {0,0,0,0,6,0,4,0,0},
-        {7,0,0,0,0,3,6,0,0},
-        {0,0,0,0,9,1,0,8,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,5,0,1,8,0,0,0,3},
-        {0,0,0,3,0,6,0,4,5},
-        {0,4,0,2,0,0,0,6,0},
-        {9,0,3,0,0,0,0,0,0},
-        {0,2,0,0,0,0,1,0,0}
-    },
-
-    { // Puzzle 8
-        {0,0,5,3,0,0,0,0,0},
-        {8,0,0,0,0,0,0,2,0},
-        {0,7,0,0,1,0,5,0,0},
-        {4,0,0,0,0,5,3,0,0},
-        {0,1,0,0,7,0,0,0,6},
-        {0,0,3,2,0,0,0,8,0},
-        {0,6,0,5,0,0,0,0,9},
-        {0,0,4,0,0,0,0,3,0},
-        {0,0,0,0,0,9,7,0,0}
-    },
-
-    { // Puzzle 9
-        {3,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,6,0,0,0},
-        {0,0,1,0,9,5,0,0,0},
-        {0,0,0,5,0,0,0,0,0},
-        {0,0,0,0,7,0,0,0,0},
-        {0,0,0,0,0,1,0,0,0},
-        {0,0,0,0,0,0,2,0,0},
-        {0,8,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,4,0}
-    },
-
-    { // Puzzle 10
-        {0,4,0,0,0,0,8,0,5},
-        {0,3,0,0,0,0,0,0,0},
-        {0,0,0,7,0,0,0,0,0},
-        {0,2,0,0,0,0,0,6,0},
-        {0,0,0,0,8,0,4,0,0},
-        {0,0,0,0,1,0,0,0,0},
-        {0,0,0,6,0,3,0,7,0},
-        {5,0,0,2,0,0,0,0,0},
-        {1,0,4,0,0,0,0,0,0}
-    },
-
-    { // Puzzle 11
-        {0,0,0,0,0,0,2,0,0},
-        {0,8,0,0,0,7,0,9,0},
-        {6,0,2,0,0,0,5,0,0},
-        {0,7,0,0,6,0,0,0,0},
-        {0,0,0,9,0,1,0,0,0},
-        {0,0,0,0,2,0,0,4,0},
-        {0,0,5,0,0,0,6,0,3},
-        {0,9,0,4,0,0,0,7,0},
-        {0,0,6,0,0,0,0,0,0}
-    },
-
-    { // Puzzle 12
-        {0,0,0,0,7,0,0,0,9},
-        {0,4,0,0,0,0,0,0,0},
-        {0,0,8,0,0,0,0,3,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,5,0,9,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,6,0,0,0,0,8,0,0},
-        {0,0,0,0,0,0,0,5,0},
-        {3,0,0,0,1,0,0,0,0}
-    },
-
-    { // Puzzle 13
-        {8,0,0,0,0,0,0,0,0},
-        {0,0,3,6,0,0,0,0,0},
-        {0,7,0,0,9,0,2,0,0},
-        {0,5,0,0,0,7,0,0,0},
-        {0,0,0,0,4,5,7,0,0},
-        {0,0,0,1,0,0,0,3,0},
-        {0,0,1,0,0,0,0,6,8},
-        {0,0,8,5,0,0,0,1,0},
-        {0,9,0,0,0,0,4,0,0}
-    },
-
-    { // Puzzle 14
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,3,0,8,5},
-        {0,0,1,0,2,0,0,0,0},
-        {0,0,0,5,0,7,0,0,0},
-        {0,0,4,0,0,0,1,0,0},
-        {0,9,0,0,0,0,0,0,0},
-        {5,0,0,0,0,0,0,7,3},
-        {0,0,2,0,1,0,0,0,0},
-        {0,0,0,0,4,0,0,0,9}
-    },
-
-    { // Puzzle 15
-        {0,0,0,3,0,0,0,0,0},
-        {0,0,0,0,0,5,0,0,0},
-        {0,0,0,0,0,0,0,7,0},
-        {0,0,0,0,0,0,3,0,0},
-        {0,0,1,0,0,0,0,0,0},
-        {0,0,0,0,6,0,0,0,0},
-        {0,0,0,0,0,0,2,0,0},
-        {0,0,0,0,0,0,0,0,8},
-        {0,0,0,0,0,0,0,0,0}
-    }
-};
-
-static const QVector<QVector<QVector<int>>> mediumPuzzles = {
-    { // Puzzle 1
-        {0,0,0,2,6,0,7,0,1},
-        {6,8,0,0,7,0,0,9,0},
-        {0,0,0,0,0,3,0,0,4},
-        {3,0,0,0,0,0,0,8,0},
-        {0,0,5,0,0,9,0,0,0},
-        {0,7,0,0,1,0,0,0,6},
-        {0,0,0,8,0,0,1,0,0},
-        {0,1,0,0,3,0,0,4,0},
-        {7,0,4,0,0,0,0,0,0}
-    },
-    { // Puzzle 2
-        {0,2,0,6,0,8,0,0,0},
-        {5,8,0,0,0,9,7,0,0},
-        {0,0,0,0,4,0,0,1,0},
-        {3,7,0,2,0,0,0,6,0},
-        {0,0,0,0,9,0,0,0,0},
-        {0,5,0,0,0,3,0,9,2},
-        {0,9,0,0,1,0,0,0,0},
-        {0,0,2,8,0,0,0,7,5},
-        {0,0,0,9,0,4,0,3,0}
-    },
-
-    { // Puzzle 3
-        {0,0,0,0,0,0,2,0,0},
-        {0,8,0,0,0,7,0,9,0},
-        {6,0,2,0,0,0,5,0,0},
-        {0,7,0,0,6,0,0,0,0},
-        {0,0,0,9,0,1,0,0,0},
-        {0,0,0,0,2,0,0,4,0},
-        {0,0,5,0,0,0,6,0,3},
-        {0,9,0,4,0,0,0,7,0},
-        {0,0,6,0,0,0,0,0,0}
-    },
-
-    { // Puzzle 4
-        {1,0,0,0,0,7,0,9,0},
-        {0,3,0,0,2,0,0,0,8},
-        {0,0,9,6,0,0,5,0,0},
-        {0,0,5,3,0,0,9,0,0},
-        {0,1,0,0,8,0,0,0,2},
-        {6,0,0,0,0,4,0,0,0},
-        {3,0,0,0,0,0,0,1,0},
-        {0,4,0,0,0,0,0,0,7},
-        {0,0,7,0,0,0,3,0,0}
-    },
-
-    { // Puzzle 5
-        {0,0,0,6,0,0,4,0,0},
-        {7,0,0,0,0,3,6,0,0},
-        {0,0,0,0,9,1,0,8,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,5,0,1,8,0,0,0,3},
-        {0,0,0,3,0,6,0,4,5},
-        {0,4,0,2,0,0,0,6,0},
-        {9,0,3,0,0,0,0,0,0},
-        {0,2,0,0,0,0,1,0,0}
-    },
-
-    { // Puzzle 6
-        {0,0,0,0,0,0,0,1,2},
-        {0,0,0,0,3,5,0,0,0},
-        {0,0,0,7,0,0,0,0,0},
-        {0,0,0,0,0,0,3,0,0},
-        {0,0,1,0,0,0,0,0,0},
-        {0,0,0,0,6,0,0,0,0},
-        {0,0,0,0,0,0,2,0,0},
-        {0,0,0,0,0,0,0,0,8},
-        {0,0,0,0,0,0,0,0,0}
-    },
-
-    { // Puzzle 7
-        {0,6,0,0,0,0,0,0,0},
-        {0,0,0,3,0,5,0,0,0},
-        {0,0,0,0,0,0,4,0,0},
-        {8,0,0,0,0,0,0,0,0},
-        {0,0,0,7,0,1,0,0,0},
-        {0,0,0,0,0,0,0,0,9},
-        {0,0,1,0,0,0,0,6,0},
-        {0,0,0,2,0,8,0,0,0},
-        {6,0,0,0,0,0,3,0,0}
-    },
-
-    { // Puzzle 8
-        {2,0,0,0,0,0,0,0,9},
-        {0,0,0,6,0,0,0,0,0},
-        {0,7,4,0,8,0,0,0,0},
-        {0,0,0,0,0,3,0,0,2},
-        {0,8,0,0,4,0,0,1,0},
-        {6,0,0,5,0,0,0,0,0},
-        {0,0,0,0,1,0,7,8,0},
-        {0,0,0,0,0,6,0,0,0},
-        {1,0,0,0,0,0,0,0,5}
-    },
-
-    { // Puzzle 9
-        {0,0,5,3,0,0,0,0,0},
-        {8,0,0,0,0,0,0,2,0},
-        {0,7,0,0,1,0,5,0,0},
-        {4,0,0,0,0,5,3,0,0},
-        {0,1,0,0,7,0,0,0,6},
-        {0,0,3,2,0,0,0,8,0},
-        {0,6,0,5,0,0,0,0,9},
-        {0,0,4,0,0,0,0,3,0},
-        {0,0,0,0,0,9,7,0,0}
-    },
-
-    { // Puzzle 10
-        {3,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,6,0,0,0},
-        {0,0,1,0,9,5,0,0,0},
-        {0,0,0,5,0,0,0,0,0},
-        {0,0,0,0,7,0,0,0,0},
-        {0,0,0,0,0,1,0,0,0},
-        {0,0,0,0,0,0,2,0,0},
-        {0,8,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,4,0}
-    },
-
-    { // Puzzle 11
-        {0,4,0,0,0,0,8,0,5},
-        {0,3,0,0,0,0,0,0,0},
-        {0,0,0,7,0,0,0,0,0},
-        {0,2,0,0,0,0,0,6,0},
-        {0,0,0,0,8,0,4,0,0},
-        {0,0,0,0,1,0,0,0,0},
-        {0,0,0,6,0,3,0,7,0},
-        {5,0,0,2,0,0,0,0,0},
-        {1,0,4,0,0,0,0,0,0}
-    },
-
-    { // Puzzle 12
-        {0,0,0,0,7,0,0,0,9},
-        {0,4,0,0,0,0,0,0,0},
-        {0,0,8,0,0,0,0,3,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,5,0,9,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,6,0,0,0,0,8,0,0},
-        {0,0,0,0,0,0,0,5,0},
-        {3,0,0,0,1,0,0,0,0}
-    },
-
-    { // Puzzle 13
-        {8,0,0,0,0,0,0,0,0},
-        {0,0,3,6,0,0,0,0,0},
-        {0,7,0,0,9,0,2,0,0},
-        {0,5,0,0,0,7,0,0,0},
-        {0,0,0,0,4,5,7,0,0},
-        {0,0,0,1,0,0,0,3,0},
-        {0,0,1,0,0,0,0,6,8},
-        {0,0,8,5,0,0,0,1,0},
-        {0,9,0,0,0,0,4,0,0}
-    },
-
-    { // Puzzle 14
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,3,0,8,5},
-        {0,0,1,0,2,0,0,0,0},
-        {0,0,0,5,0,7,0,0,0},
-        {0,0,4,0,0,0,1,0,0},
-        {0,9,0,0,0,0,0,0,0},
-        {5,0,0,0,0,0,0,7,3},
-        {0,0,2,0,1,0,0,0,0},
-        {0,0,0,0,4,0,0,0,9}
-    },
-
-    { // Puzzle 15
-        {0,0,0,3,0,0,0,0,0},
-        {0,0,0,0,0,5,0,0,0},
-        {0,0,0,0,0,0,0,7,0},
-        {0,0,0,0,0,0,3,0,0},
-        {0,0,1,0,0,0,0,0,0},
-        {0,0,0,0,6,0,0,0,0},
-        {0,0,0,0,0,0,2,0,0},
-        {0,0,0,0,0,0,0,0,8},
-        {0,0,0,0,0,0,0,0,0}
-    }
-};
-
-static const QVector<QVector<QVector<int>>> hardPuzzles = {
-    { // Puzzle 1
-        {0,0,0,6,0,0,4,0,0},
-        {7,0,0,0,0,3,6,0,0},
-        {0,0,0,0,9,1,0,8,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,5,0,1,8,0,0,0,3},
-        {0,0,0,3,0,6,0,4,5},
-        {0,4,0,2,0,0,0,6,0},
-        {9,0,3,0,0,0,0,0,0},
-        {0,2,0,0,0,0,1,0,0}
-    },
-    { // Puzzle 2
-        {0,8,0,0,0,9,0,3,0},
-        {6,0,0,7,0,0,1,0,0},
-        {0,2,0,0,4,0,0,0,9},
-        {2,0,9,0,0,3,0,0,7},
-        {0,0,0,0,1,0,0,0,0},
-        {8,0,0,6,0,0,2,0,3},
-        {4,0,0,0,9,0,0,7,0},
-        {0,0,7,0,0,8,0,0,5},
-        {0,3,0,5,0,0,0,1,0}
-    },
-
-    { // Puzzle 3
-        {0,0,0,0,0,0,0,1,2},
-        {0,0,0,0,3,5,0,0,0},
-        {0,0,0,7,0,0,0,0,0},
-        {0,0,0,0,0,0,3,0,0},
-        {0,0,1,0,0,0,0,0,0},
-        {0,0,0,0,6,0,0,0,0},
-        {0,0,0,0,0,0,2,0,0},
-        {0,0,0,0,0,0,0,0,8},
-        {0,0,0,0,0,0,0,0,0}
-    },
-
-    { // Puzzle 4
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,3,0,8,5},
-        {0,0,1,0,2,0,0,0,0},
-        {0,0,0,5,0,7,0,0,0},
-        {0,0,4,0,0,0,1,0,0},
-        {0,9,0,0,0,0,0,0,0},
-        {5,0,0,0,0,0,0,7,3},
-        {0,0,2,0,1,0,0,0,0},
-        {0,0,0,0,4,0,0,0,9}
-    },
-
-    { // Puzzle 5
-        {8,0,0,0,0,0,0,0,0},
-        {0,0,3,6,0,0,0,0,0},
-        {0,7,0,0,9,0,2,0,0},
-        {0,5,0,0,0,7,0,0,0},
-        {0,0,0,0,4,5,7,0,0},
-        {0,0,0,1,0,0,0,3,0},
-        {0,0,1,0,0,0,0,6,8},
-        {0,0,8,5,0,0,0,1,0},
-        {0,9,0,0,0,0,4,0,0}
-    },
-
-    { // Puzzle 6
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0}
-    },
-
-    { // Puzzle 7
-        {0,0,0,0,0,0,0,0,1},
-        {0,0,0,0,0,2,0,0,0},
-        {0,0,0,0,3,0,0,0,0},
-        {0,0,0,4,0,0,0,0,0},
-        {0,0,5,0,0,0,0,0,0},
-        {0,6,0,0,0,0,0,0,0},
-        {7,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,8,0,0},
-        {0,0,0,0,0,0,0,0,0}
-    },
-
-    { // Puzzle 8
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,1,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0}
-    },
-
-    { // Puzzle 9
-        {1,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,2},
-        {0,0,0,0,0,3,0,0,0},
-        {0,0,0,0,4,0,0,0,0},
-        {0,0,0,5,0,0,0,0,0},
-        {0,0,6,0,0,0,0,0,0},
-        {0,7,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,8,0,0},
-        {0,0,0,0,0,0,0,0,0}
-    },
-
-    { // Puzzle 10
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,9,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0}
-    },
-
-    { // Puzzle 11
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,2,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0}
-    },
-
-    { // Puzzle 12
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,3,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0}
-    },
-
-    { // Puzzle 13
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,4,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0}
-    },
-
-    { // Puzzle 14
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,5,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0}
-    },
-
-    { // Puzzle 15
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,6,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0},
-        {0,0,0,0,0,0,0,0,0}
-    }
-};
+static SudokuGenerator::Difficulty toGeneratorDifficulty(const QString &difficulty)
+{
+    if (difficulty == "easy") return SudokuGenerator::Difficulty::Easy;
+    if (difficulty == "medium") return SudokuGenerator::Difficulty::Medium;
+    return SudokuGenerator::Difficulty::Hard;
+}
 
 GameScreen::GameScreen(QWidget *parent) : QWidget(parent)
 {
     selectedRow = selectedCol = -1;
+    instantSolve = false;
+    boxSize = 3;
+    model = new SudokuModel(this);
+    hinter = new SudokuHint(model, this);
     setupUI();
+    // Any edit makes a hint on show stale
+    connect(model, &SudokuModel::modelReset, this, &GameScreen::dropPendingHint);
+    connect(model, &SudokuModel::cellChanged, this, &GameScreen::dropPendingHint);
+    connect(model, &SudokuModel::cellsChanged, this, &GameScreen::dropPendingHint);
     solver = new SudokuSolver(this);
-    connect(solver, &SudokuSolver::cellUpdated, this, &GameScreen::onSolverCellUpdated);
+    connect(solver, &SudokuSolver::cellsUpdated, this, &GameScreen::onSolverCellsUpdated);
+    connect(solver, &SudokuSolver::solutionReady, this, &GameScreen::onSolverSolutionReady);
+    connect(solver, &SudokuSolver::traceReady, this, &GameScreen::onSolverTraceReady);
+    connect(solver->playback(), &SudokuPlayback::frameFinished, this, &GameScreen::onPlaybackFrame);
+    connect(playbackSlider, &QSlider::sliderMoved, solver->playback(), &SudokuPlayback::seek);
     connect(solver, &SudokuSolver::solvingFinished, this, &GameScreen::onSolverFinished);
+    connect(solver, &SudokuSolver::statsUpdated, this, &GameScreen::onSolverStats);
 
     timer = new QTimer(this);
     connect(timer, &QTimer::timeout, this, &GameScreen::updateTimerDisplay);
     elapsedSeconds = 0;
+    elapsedOffsetMs = 0;
+    clockRunning = false;
+    gameInProgress = false;
+
+    puzzlePending = false;
+    puzzlePool = new SudokuPuzzlePool("sudoku_pool.dat", this);
+    connect(puzzlePool, &SudokuPuzzlePool::puzzleReady, this, &GameScreen::onPuzzleReady);
+    currentRules = SudokuVariants::Rules::Classic;
+    variantWatcher = new QFutureWatcher<SudokuVariants::Puzzle>(this);
+    connect(variantWatcher, &QFutureWatcher<SudokuVariants::Puzzle>::finished, this, &GameScreen::onVariantReady);
+    library.open("sudoku_library.dat");
+    currentSeed = 0;
+    puzzleFromLibrary = false;
 }
 
 QPushButton* GameScreen::createButton(const QString &text, const QString &bgColor, const QString &hoverColor)
@@ -583,9 +78,11 @@ QPushButton* GameScreen::createButton(const QString &text, const QString &bgColo
 
 QPushButton* GameScreen::createNumberButton(int number)
 {
-    QPushButton *btn = new QPushButton(QString::number(number), this);
-    btn->setFixedSize(70, 70);
-    btn->setFont(QFont("Arial", 24, QFont::Bold));
+    // Keypad stays 230px wide whatever the board size
+    int side = (230 - (boxSize - 1) * 10) / boxSize;
+    QPushButton *btn = new QPushButton(SudokuBoard::symbolFor(number), this);
+    btn->setFixedSize(side, side);
+    btn->setFont(QFont("Arial", side * 24 / 70, QFont::Bold));
     btn->setStyleSheet(
         "QPushButton { background-color: #ecf0f1; color: #2c3e50; border: 1px solid #bdc3c7; border-radius: 10px; }"
         "QPushButton:hover { background-color: #bdc3c7; }"
@@ -604,6 +101,7 @@ void GameScreen::setupUI()
 
     // Left: Sudoku board
     board = new SudokuBoard(this);
+    board->setModel(model);
     board->setFixedSize(600, 600);
     connect(board, &SudokuBoard::cellFocused, this, &GameScreen::onCellFocused);
     mainLayout->addWidget(board);
@@ -628,23 +126,21 @@ void GameScreen::setupUI()
     timerLabel->setAlignment(Qt::AlignCenter);
     timerLabel->setFixedWidth(120);
 
+    seedLabel = new QLabel(this);
+    seedLabel->setFont(QFont("Arial", 9));
+    seedLabel->setAlignment(Qt::AlignCenter);
+    seedLabel->setStyleSheet("color: #95a5a6;");
+    seedLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
     rightPanel->addWidget(timeCaptionLabel);
     rightPanel->addWidget(timerLabel, 0, Qt::AlignHCenter);
+    rightPanel->addWidget(seedLabel);
     rightPanel->addSpacing(10);
 
-    // Keypad 3x3 grid
+    // Keypad, one button per digit in a box-shaped grid
     keypadLayout = new QGridLayout();
     keypadLayout->setSpacing(10);
-    int pos = 0;
-    for (int r = 0; r < 3; ++r) {
-        for (int c = 0; c < 3; ++c) {
-            int num = pos + 1;
-            QPushButton *btn = createNumberButton(num);
-            numberButtons.append(btn);
-            keypadLayout->addWidget(btn, r, c);
-            pos++;
-        }
-    }
+    rebuildKeypad();
     rightPanel->addLayout(keypadLayout);
 
     // New Game button (already 230px)
@@ -660,18 +156,65 @@ void GameScreen::setupUI()
 
     rightPanel->addSpacing(5);
 
-    // Other three buttons (now same width)
+    // Other buttons (now same width)
     undoButton = createButton("UNDO", "#3498db", "#2980b9");
+    redoButton = createButton("REDO", "#3498db", "#2980b9");
+    undoButton->setFixedWidth(110);
+    redoButton->setFixedWidth(110);
     clearAllButton = createButton("CLEAR ALL", "#e67e22", "#d35400");
+    hintButton = createButton("HINT", "#f1c40f", "#d4ac0d");
+    notesButton = createButton("NOTES: OFF", "#7f8c8d", "#707b7c");
+    notesButton->setCheckable(true);
     solveButton = createButton("SOLVE", "#9b59b6", "#8e44ad");
+    instantSolveButton = createButton("INSTANT SOLVE", "#16a085", "#138d75");
 
     connect(undoButton, &QPushButton::clicked, this, &GameScreen::onUndoClicked);
+    connect(redoButton, &QPushButton::clicked, this, &GameScreen::onRedoClicked);
     connect(clearAllButton, &QPushButton::clicked, this, &GameScreen::onClearAllClicked);
+    connect(hintButton, &QPushButton::clicked, this, &GameScreen::onHintClicked);
+    connect(notesButton, &QPushButton::toggled, this, &GameScreen::onNotesToggled);
     connect(solveButton, &QPushButton::clicked, this, &GameScreen::onSolveClicked);
+    connect(instantSolveButton, &QPushButton::clicked, this, &GameScreen::onInstantSolveClicked);
 
-    rightPanel->addWidget(undoButton);
+    QHBoxLayout *historyRow = new QHBoxLayout();
+    historyRow->setSpacing(10);
+    historyRow->addWidget(undoButton);
+    historyRow->addWidget(redoButton);
+    rightPanel->addLayout(historyRow);
     rightPanel->addWidget(clearAllButton);
+    rightPanel->addWidget(hintButton);
+    rightPanel->addWidget(notesButton);
     rightPanel->addWidget(solveButton);
+    rightPanel->addWidget(instantSolveButton);
+
+    // Explanation of the last hint
+    hintLabel = new QLabel(this);
+    hintLabel->setFont(QFont("Arial", 10));
+    hintLabel->setFixedWidth(230);
+    hintLabel->setWordWrap(true);
+    hintLabel->setStyleSheet("color: #2c3e50;");
+    rightPanel->addWidget(hintLabel);
+
+    // Scrub bar for the solver replay, only visible while it plays
+    playbackSlider = new QSlider(Qt::Horizontal, this);
+    playbackSlider->setFixedWidth(230);
+    playbackSlider->hide();
+    rightPanel->addWidget(playbackSlider);
+
+    // Solver backend and the stats panel, for comparing the two on one puzzle
+    backendCombo = new QComboBox(this);
+    backendCombo->setFixedWidth(230);
+    backendCombo->setFont(QFont("Arial", 10));
+    backendCombo->addItem("Propagation solver");
+    backendCombo->addItem("Dancing Links solver");
+    connect(backendCombo, &QComboBox::currentIndexChanged, this, &GameScreen::onBackendChanged);
+    rightPanel->addWidget(backendCombo);
+
+    statsCheck = new QCheckBox("Show solver stats", this);
+    statsCheck->setFont(QFont("Arial", 10));
+    statsCheck->setStyleSheet("color: #2c3e50;");
+    connect(statsCheck, &QCheckBox::toggled, this, &GameScreen::onStatsToggled);
+    rightPanel->addWidget(statsCheck);
     rightPanel->addStretch();
 
     mainLayout->addLayout(rightPanel);
@@ -688,6 +231,15 @@ void GameScreen::setupUI()
     backButton->raise();
     connect(backButton, &QPushButton::clicked, this, &GameScreen::onBackClicked);
 
+    // Stats panel floats over the board's top-left corner
+    statsLabel = new QLabel(this);
+    statsLabel->setFont(QFont("Courier New", 10));
+    statsLabel->setStyleSheet(
+        "QLabel { color: white; background-color: rgba(44, 62, 80, 200); border-radius: 6px; padding: 8px; }"
+        );
+    statsLabel->setAttribute(Qt::WA_TransparentForMouseEvents);
+    statsLabel->hide();
+
     // Win overlay (increased height)
     overlay = new QWidget(this);
     overlay->setGeometry(rect());
@@ -728,10 +280,34 @@ void GameScreen::setupUI()
     overlayLayout->addWidget(centerBox);
 }
 
+void GameScreen::rebuildKeypad()
+{
+    qDeleteAll(numberButtons);
+    numberButtons.clear();
+    int pos = 0;
+    for (int r = 0; r < boxSize; ++r) {
+        for (int c = 0; c < boxSize; ++c) {
+            int num = pos + 1;
+            QPushButton *btn = createNumberButton(num);
+            numberButtons.append(btn);
+            keypadLayout->addWidget(btn, r, c);
+            pos++;
+        }
+    }
+}
+
 void GameScreen::resizeEvent(QResizeEvent *event)
 {
     QWidget::resizeEvent(event);
     overlay->setGeometry(rect());
+    placeStatsLabel();
+}
+
+void GameScreen::placeStatsLabel()
+{
+    statsLabel->adjustSize();
+    statsLabel->move(board->geometry().topLeft() + QPoint(10, 10));
+    statsLabel->raise();
 }
 
 void GameScreen::onCellFocused(int row, int col)
@@ -743,25 +319,47 @@ void GameScreen::onCellFocused(int row, int col)
 void GameScreen::onNumberButtonClicked(int number)
 {
     if (selectedRow == -1 || selectedCol == -1) return;
+    if (board->notesMode()) {
+        board->toggleNote(selectedRow, selectedCol, number);
+        return;
+    }
     if (board->isCellReadOnly(selectedRow, selectedCol)) return;
     board->setValue(selectedRow, selectedCol, number, true);  // record undo
 }
 
 void GameScreen::onBackClicked()
 {
+    saveSession();
     stopTimer();
     emit backToHomeClicked();
 }
 
-void GameScreen::startNewGame(const QString &difficulty)
+void GameScreen::startNewGame(const QString &difficulty, int boxSize, SudokuVariants::Rules rules)
 {
     currentDifficulty = difficulty;
-    generatePuzzle(difficulty);
+    currentRules = rules;
+    if (rules != SudokuVariants::Rules::Classic)
+        boxSize = 3;
+    if (boxSize != this->boxSize) {
+        this->boxSize = boxSize;
+        rebuildKeypad();
+    }
+    if (generatePuzzle(difficulty))
+        beginPlay(0);
+}
 
-    elapsedSeconds = 0;
-    timerLabel->setText("00:00");
-    elapsedTimer.start();
-    timer->start(1000);
+void GameScreen::beginPlay(qint64 elapsedMs)
+{
+    puzzlePending = false;
+    elapsedOffsetMs = elapsedMs;
+    clockRunning = false;
+    gameInProgress = true;
+    // A game resumed at startup, or started from the home screen, is not on
+    // screen yet; showEvent starts the clock when it is
+    if (isVisible())
+        resumeTimer();
+    else
+        updateTimerDisplay();
 
     hideWinOverlay();
     setButtonsEnabled(true);
@@ -770,30 +368,210 @@ void GameScreen::startNewGame(const QString &difficulty)
     selectedRow = selectedCol = -1;
 }
 
+void GameScreen::saveSession()
+{
+    if (!gameInProgress) return;
+    if (solver->isSolving()) {
+        // The replay has written solver digits the history never saw; the
+        // game is being solved anyway, so end it as a finished solve would
+        session.discard();
+        return;
+    }
+
+    SudokuSession::Snapshot snapshot;
+    snapshot.box = boxSize;
+    snapshot.difficulty = currentDifficulty;
+    snapshot.rules = QString::fromStdString(SudokuVariants::rulesText(model->constraints()));
+    snapshot.seed = currentSeed;
+    snapshot.fromLibrary = puzzleFromLibrary;
+    snapshot.elapsedMs = playedMs();
+    for (int cell = 0; cell < model->cellCount(); ++cell) {
+        bool given = model->isGiven(cell);
+        snapshot.givens.push_back(given ? model->value(cell) : 0);
+        snapshot.entries.push_back(given ? 0 : model->value(cell));
+        snapshot.notes.push_back(model->notes(cell));
+    }
+    snapshot.history = board->undoHistory().packedOps();
+    snapshot.historyPosition = board->undoHistory().position();
+    session.save(snapshot);
+}
+
+bool GameScreen::resumeSession()
+{
+    SudokuSession::Snapshot snapshot;
+    if (!session.load(snapshot)) return false;
+    SudokuUnits units(3);
+    if (!SudokuVariants::parseRules(snapshot.rules.toStdString(), units)) return false;
+    SudokuVariants::Rules rules = SudokuVariants::rulesOf(units);
+    if (rules != SudokuVariants::Rules::Classic && snapshot.box != 3) return false;
+
+    currentDifficulty = snapshot.difficulty;
+    currentRules = rules;
+    currentSeed = snapshot.seed;
+    puzzleFromLibrary = snapshot.fromLibrary;
+    if (snapshot.box != boxSize) {
+        boxSize = snapshot.box;
+        rebuildKeypad();
+    }
+    if (rules == SudokuVariants::Rules::Classic)
+        model->restore(snapshot.box, snapshot.givens, snapshot.entries, snapshot.notes);
+    else
+        model->restore(units, snapshot.givens, snapshot.entries, snapshot.notes);
+    board->restoreHistory(snapshot.history, snapshot.historyPosition);
+    if (rules != SudokuVariants::Rules::Classic)
+        seedLabel->setText(QString("%1 %2\nResumed")
+                               .arg(SudokuVariants::name(rules))
+                               .arg(currentSeed, 16, 16, QChar('0')));
+    else if (puzzleFromLibrary)
+        seedLabel->setText(QString("Library puzzle %1\nResumed").arg(currentSeed + 1));
+    else
+        seedLabel->setText(QString("Puzzle %1\nResumed").arg(currentSeed, 16, 16, QChar('0')));
+    hintLabel->clear();
+    beginPlay(snapshot.elapsedMs);
+    return true;
+}
+
 void GameScreen::stopTimer()
 {
     timer->stop();
+    if (!clockRunning) return;
+    elapsedOffsetMs += elapsedTimer.elapsed();
+    clockRunning = false;
 }
 
-void GameScreen::generatePuzzle(const QString &difficulty)
+void GameScreen::resumeTimer()
 {
-    int index;
-    if (difficulty == "easy") {
-        index = QRandomGenerator::global()->bounded(easyPuzzles.size());
-        initialBoard = easyPuzzles[index];
-    } else if (difficulty == "medium") {
-        index = QRandomGenerator::global()->bounded(mediumPuzzles.size());
-        initialBoard = mediumPuzzles[index];
+    if (!gameInProgress || clockRunning) return;
+    elapsedTimer.start();
+    clockRunning = true;
+    timer->start(1000);
+    updateTimerDisplay();
+}
+
+qint64 GameScreen::playedMs() const
+{
+    return elapsedOffsetMs + (clockRunning ? elapsedTimer.elapsed() : 0);
+}
+
+void GameScreen::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    resumeTimer();
+}
+
+void GameScreen::hideEvent(QHideEvent *event)
+{
+    QWidget::hideEvent(event);
+    stopTimer();
+}
+
+bool GameScreen::generatePuzzle(const QString &difficulty)
+{
+    SudokuGenerator::Difficulty level = toGeneratorDifficulty(difficulty);
+    int size = boxSize * boxSize;
+    std::vector<uint8_t> givens;
+
+    if (currentRules != SudokuVariants::Rules::Classic) {
+        // Up to a few hundred ms for a Jigsaw, so never on this thread
+        generateVariant(level);
+        return false;
+    } else if (boxSize == 3 && library.count(level) > 0) {
+        // Any of the library's puzzles, straight from the mapping
+        int available = library.count(level);
+        int index = QRandomGenerator::global()->bounded(available);
+        SudokuEngine::Grid picked;
+        library.puzzle(level, index, picked);
+        currentSeed = index;
+        puzzleFromLibrary = true;
+        seedLabel->setText(QString("Library puzzle %1 of %2").arg(index + 1).arg(available));
+        givens.assign(picked.begin(), picked.end());
+    } else if (boxSize == 3) {
+        SudokuGenerator::Puzzle puzzle;
+        if (!puzzlePool->pop(level, puzzle)) {
+            // Empty stock (first run, or New Game clicked faster than the
+            // worker refills): the worker makes one next, never this thread
+            waitForPuzzle(level);
+            return false;
+        }
+        currentSeed = puzzle.seed;
+        puzzleFromLibrary = false;
+        seedLabel->setText(QString("Puzzle %1\nHardest step: %2 (score %3)")
+                               .arg(currentSeed, 16, 16, QChar('0'))
+                               .arg(SudokuLogic::techniqueName(puzzle.hardest))
+                               .arg(puzzle.score));
+        givens.assign(puzzle.givens.begin(), puzzle.givens.end());
     } else {
-        index = QRandomGenerator::global()->bounded(hardPuzzles.size());
-        initialBoard = hardPuzzles[index];
+        // Larger boards are cheap to dig and are not pooled
+        SudokuGenerator::Board generated =
+            SudokuGenerator::generateBoard(boxSize, QRandomGenerator::global()->generate64(), level);
+        currentSeed = generated.seed;
+        puzzleFromLibrary = false;
+        seedLabel->setText(QString("Puzzle %1\n%2x%2")
+                               .arg(currentSeed, 16, 16, QChar('0'))
+                               .arg(size));
+        givens = generated.givens;
     }
-    board->setBoard(initialBoard, initialBoard);
+    model->reset(boxSize, givens);
+    hintLabel->clear();
+    return true;
+}
+
+void GameScreen::waitForPuzzle(SudokuGenerator::Difficulty level)
+{
+    showPending();
+    puzzlePool->request(level);
+}
+
+void GameScreen::generateVariant(SudokuGenerator::Difficulty level)
+{
+    showPending();
+    SudokuVariants::Rules rules = currentRules;
+    quint64 seed = QRandomGenerator::global()->generate64();
+    // A newer request replaces the watched future; the old one finishes unseen
+    variantWatcher->setFuture(QtConcurrent::run([rules, seed, level]() {
+        return SudokuVariants::generate(rules, seed, level);
+    }));
+}
+
+// Board and controls locked, Back still live, until the puzzle arrives
+void GameScreen::showPending()
+{
+    puzzlePending = true;
+    stopTimer();
+    gameInProgress = false;
+    hideWinOverlay();
+    hintLabel->clear();
+    seedLabel->setText("Generating a puzzle...");
+    board->setAllCellsEnabled(false);
+    setButtonsEnabled(false);
+    setKeypadEnabled(false);
+    backButton->setEnabled(true);
+}
+
+void GameScreen::onPuzzleReady()
+{
+    if (puzzlePending && currentRules == SudokuVariants::Rules::Classic && generatePuzzle(currentDifficulty))
+        beginPlay(0);
+}
+
+void GameScreen::onVariantReady()
+{
+    // A classic game may have been started while this one was generating
+    if (!puzzlePending || currentRules == SudokuVariants::Rules::Classic) return;
+    SudokuVariants::Puzzle puzzle = variantWatcher->result();
+    currentSeed = puzzle.seed;
+    puzzleFromLibrary = false;
+    seedLabel->setText(QString("%1 %2")
+                           .arg(SudokuVariants::name(puzzle.rules))
+                           .arg(currentSeed, 16, 16, QChar('0')));
+    model->reset(puzzle.units, puzzle.givens);
+    hintLabel->clear();
+    beginPlay(0);
 }
 
 void GameScreen::updateTimerDisplay()
 {
-    elapsedSeconds = elapsedTimer.elapsed() / 1000;
+    elapsedSeconds = playedMs() / 1000;
     int minutes = elapsedSeconds / 60;
     int seconds = elapsedSeconds % 60;
     timerLabel->setText(QString("%1:%2")
@@ -806,6 +584,11 @@ void GameScreen::onUndoClicked()
     board->undo();
 }
 
+void GameScreen::onRedoClicked()
+{
+    board->redo();
+}
+
 void GameScreen::onClearAllClicked()
 {
     board->clearUserEntries();
@@ -813,38 +596,176 @@ void GameScreen::onClearAllClicked()
 
 void GameScreen::onNewGameClicked()
 {
-    generatePuzzle(currentDifficulty);
-    elapsedSeconds = 0;
-    timerLabel->setText("00:00");
-    elapsedTimer.restart();
+    startNewGame(currentDifficulty, boxSize, currentRules);
+}
+
+void GameScreen::onHintClicked()
+{
+    // A second press enters the hint on show as one undoable move
+    if (!pendingHint.empty()) {
+        std::vector<SudokuChange> move;
+        move.swap(pendingHint);
+        board->applyMove(move);
+        return;
+    }
+
+    SudokuHint::Hint hint = hinter->next();
+    board->setHighlights(hint.pattern, hint.targets);
+    hintLabel->setText(hint.text);
+    pendingHint = hint.placements;
+    if (!pendingHint.empty())
+        hintButton->setText("APPLY HINT");
+}
+
+void GameScreen::dropPendingHint()
+{
+    pendingHint.clear();
+    hintButton->setText("HINT");
+}
+
+void GameScreen::onNotesToggled(bool enabled)
+{
+    board->setNotesMode(enabled);
+    notesButton->setText(enabled ? "NOTES: ON" : "NOTES: OFF");
 }
 
 void GameScreen::onSolveClicked()
 {
+    // While the replay runs the button skips straight to the end
+    if (solver->isSolving()) {
+        solver->playback()->skipToEnd();
+        return;
+    }
+    instantSolve = false;
+    beginSolving();
+    solver->startSolving(50);
+}
+
+void GameScreen::onInstantSolveClicked()
+{
+    instantSolve = true;
+    beginSolving();
+    solver->solveInstantly();
+}
+
+void GameScreen::beginSolving()
+{
+    hintLabel->clear();
     board->setAllCellsEnabled(false);
     setButtonsEnabled(false);
     setKeypadEnabled(false);
 
-    QVector<QVector<int>> currentBoard(9, QVector<int>(9, 0));
-    for (int r = 0; r < 9; ++r)
-        for (int c = 0; c < 9; ++c)
-            currentBoard[r][c] = board->getValue(r, c);
+    solver->setBoard(*model);
+}
+
+void GameScreen::onSolverCellsUpdated(const std::vector<SudokuChange> &changes)
+{
+    // A whole replay frame at once; no undo for solver moves
+    model->setValues(changes);
+}
 
-    solver->setBoard(currentBoard);
-    solver->startSolving(50);
+void GameScreen::onSolverSolutionReady(const std::vector<uint8_t> &solution)
+{
+    // Whole solution in one pass and one repaint
+    std::vector<SudokuChange> changes;
+    changes.reserve(solution.size());
+    for (int cell = 0; cell < static_cast<int>(solution.size()); ++cell) {
+        if (model->value(cell) != solution[cell])
+            changes.push_back({static_cast<uint16_t>(cell), solution[cell]});
+    }
+    model->setValues(changes);
+}
+
+void GameScreen::onSolverTraceReady(int length)
+{
+    playbackSlider->setRange(0, length);
+    playbackSlider->setValue(0);
+    playbackSlider->show();
+    solveButton->setText("SKIP");
+    solveButton->setEnabled(true);
+}
+
+void GameScreen::onPlaybackFrame(int position)
+{
+    if (statsCheck->isChecked())
+        showSolverStats(position);
+    if (playbackSlider->isSliderDown()) return;
+    QSignalBlocker blocker(playbackSlider);
+    playbackSlider->setValue(position);
+}
+
+void GameScreen::onSolverStats()
+{
+    if (statsCheck->isChecked())
+        showSolverStats(-1);
+}
+
+void GameScreen::onBackendChanged(int index)
+{
+    solver->setBackend(index == 1 ? SudokuSolver::Backend::DancingLinks : SudokuSolver::Backend::Propagation);
+}
+
+void GameScreen::onStatsToggled(bool enabled)
+{
+    if (enabled) showSolverStats(-1);
+    else statsLabel->hide();
 }
 
-void GameScreen::onSolverCellUpdated(int row, int col, int value)
+void GameScreen::showSolverStats(int replayPosition)
 {
-    board->setValue(row, col, value, false);  // no undo for solver
-    QApplication::processEvents();
+    // replayPosition is the playback frame while a replay runs, -1 otherwise
+    const SudokuSolver::Stats &stats = solver->lastStats();
+    if (stats.boxSize == 0) {
+        statsLabel->setText("No solve yet");
+    } else {
+        int size = stats.boxSize * stats.boxSize;
+        QString replay;
+        if (replayPosition >= 0)
+            replay = QString("%1 / %2").arg(replayPosition).arg(stats.traceLength);
+        else if (stats.traceLength > 0)
+            replay = QString("%1 ms, %2 steps").arg(stats.replayUs / 1000).arg(stats.traceLength);
+        else
+            replay = "-";
+        statsLabel->setText(QString(
+            "%1  %2x%2  %3\n"
+            "nodes       %4\n"
+            "backtracks  %5\n"
+            "max depth   %6\n"
+            "rounds      %7\n"
+            "setup       %8 µs\n"
+            "search      %9 µs\n"
+            "replay      %10")
+            .arg(stats.variant ? "Variant" : stats.backend == SudokuSolver::Backend::DancingLinks ? "DLX" : "Propagation")
+            .arg(size)
+            .arg(stats.solved ? "solved" : "unsolvable")
+            .arg(stats.nodes)
+            .arg(stats.backtracks)
+            .arg(stats.maxDepth)
+            .arg(stats.backend == SudokuSolver::Backend::DancingLinks && !stats.variant ? QString("-") : QString::number(stats.rounds))
+            .arg(stats.setupUs)
+            .arg(stats.searchUs)
+            .arg(replay));
+    }
+    statsLabel->show();
+    placeStatsLabel();
 }
 
-void GameScreen::onSolverFinished(bool solved, int timeMs)
+void GameScreen::onSolverFinished(bool solved, qint64 elapsedUs)
 {
+    playbackSlider->hide();
+    solveButton->setText("SOLVE");
     if (solved) {
-        timer->stop();
-        showWinOverlay(timeMs);
+        stopTimer();
+        gameInProgress = false;
+        session.discard();
+        if (instantSolve) {
+            showWinOverlay(QString("Solved in %1 µs").arg(elapsedUs));
+        } else {
+            int seconds = elapsedUs / 1000000;
+            showWinOverlay(QString("Completed in %1:%2")
+                               .arg(seconds / 60, 2, 10, QChar('0'))
+                               .arg(seconds % 60, 2, 10, QChar('0')));
+        }
     } else {
         board->setAllCellsEnabled(true);
         setButtonsEnabled(true);
@@ -855,17 +776,12 @@ void GameScreen::onSolverFinished(bool solved, int timeMs)
 void GameScreen::onNewGameFromOverlay()
 {
     hideWinOverlay();
-    startNewGame(currentDifficulty);
+    startNewGame(currentDifficulty, boxSize, currentRules);
 }
 
-void GameScreen::showWinOverlay(int timeMs)
+void GameScreen::showWinOverlay(const QString &message)
 {
-    int seconds = timeMs / 1000;
-    int minutes = seconds / 60;
-    seconds %= 60;
-    winTimeLabel->setText(QString("Completed in %1:%2")
-                              .arg(minutes, 2, 10, QChar('0'))
-                              .arg(seconds, 2, 10, QChar('0')));
+    winTimeLabel->setText(message);
     overlay->setGeometry(rect());
     overlay->show();
     overlay->raise();
@@ -879,8 +795,13 @@ void GameScreen::hideWinOverlay()
 void GameScreen::setButtonsEnabled(bool enabled)
 {
     undoButton->setEnabled(enabled);
+    redoButton->setEnabled(enabled);
     clearAllButton->setEnabled(enabled);
+    hintButton->setEnabled(enabled && boxSize == 3 && model->constraints().isClassic());   // the techniques are classic 9x9 only
+    notesButton->setEnabled(enabled);
     solveButton->setEnabled(enabled);
+    instantSolveButton->setEnabled(enabled);
+    backendCombo->setEnabled(enabled);
     backButton->setEnabled(enabled);
     newGameButton->setEnabled(enabled);
 }
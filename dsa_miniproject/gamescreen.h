@@ -8,10 +8,21 @@
 #include <QPushButton>
 #include <QLabel>
 #include <QGridLayout>
+#include <QSlider>
+#include <QCheckBox>
+#include <QComboBox>
+#include <QFutureWatcher>
+#include "sudokugenerator.h"
+#include "sudokulibrary.h"
+#include "sudokusession.h"
+#include "sudokuvariants.h"
 
 QT_BEGIN_NAMESPACE
 class SudokuBoard;
+class SudokuHint;
+class SudokuModel;
 class SudokuSolver;
+class SudokuPuzzlePool;
 QT_END_NAMESPACE
 
 class GameScreen : public QWidget
@@ -20,23 +31,46 @@ class GameScreen : public QWidget
 
 public:
     explicit GameScreen(QWidget *parent = nullptr);
-    void startNewGame(const QString &difficulty);
+    // Variants are 9x9 only; boxSize is ignored for them
+    void startNewGame(const QString &difficulty, int boxSize = 3,
+                      SudokuVariants::Rules rules = SudokuVariants::Rules::Classic);
+    // Pauses the game clock, keeping the time played so far; it runs again
+    // once the screen is shown
     void stopTimer();
 
+    // Game in progress to and from disk; resume returns false if none
+    void saveSession();
+    bool resumeSession();
+
 signals:
     void backToHomeClicked();
 
 protected:
     void resizeEvent(QResizeEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
 
 private slots:
     void updateTimerDisplay();
     void onUndoClicked();
+    void onRedoClicked();
     void onClearAllClicked();
     void onNewGameClicked();
+    void onHintClicked();
+    void onNotesToggled(bool enabled);
+    void dropPendingHint();
     void onSolveClicked();
-    void onSolverCellUpdated(int row, int col, int value);
-    void onSolverFinished(bool solved, int timeMs);
+    void onInstantSolveClicked();
+    void onSolverCellsUpdated(const std::vector<SudokuChange> &changes);
+    void onSolverSolutionReady(const std::vector<uint8_t> &solution);
+    void onSolverTraceReady(int length);
+    void onPlaybackFrame(int position);
+    void onSolverFinished(bool solved, qint64 elapsedUs);
+    void onPuzzleReady();
+    void onVariantReady();
+    void onSolverStats();
+    void onBackendChanged(int index);
+    void onStatsToggled(bool enabled);
     void onNewGameFromOverlay();
     void onBackClicked();
     void onNumberButtonClicked(int number);
@@ -46,25 +80,50 @@ private:
     QPushButton* createButton(const QString &text, const QString &bgColor, const QString &hoverColor);
     QPushButton* createNumberButton(int number);
 
+    SudokuModel *model;
     SudokuBoard *board;
     SudokuSolver *solver;
+    SudokuHint *hinter;
     QLabel *timeCaptionLabel;
     QLabel *timerLabel;
+    QLabel *seedLabel;
 
     QVector<QPushButton*> numberButtons;
     QGridLayout *keypadLayout;
     QPushButton *newGameButton;
     QPushButton *undoButton;
+    QPushButton *redoButton;
     QPushButton *clearAllButton;
+    QPushButton *hintButton;
+    QPushButton *notesButton;
     QPushButton *solveButton;
+    QPushButton *instantSolveButton;
+    QLabel *hintLabel;
+    std::vector<SudokuChange> pendingHint;   // placements of the hint on show
+    QSlider *playbackSlider;
+    QComboBox *backendCombo;
+    QCheckBox *statsCheck;
+    QLabel *statsLabel;   // solver counters drawn over the board
     QPushButton *backButton;
 
     QTimer *timer;
     QElapsedTimer elapsedTimer;
+    qint64 elapsedOffsetMs;   // play time up to the last pause, or from a resumed session
+    bool clockRunning;        // elapsedTimer counts on top of elapsedOffsetMs
     int elapsedSeconds;
 
-    QVector<QVector<int>> initialBoard;
     QString currentDifficulty;
+    int boxSize;   // 3 for 9x9, 4 for 16x16, 5 for 25x25
+    SudokuVariants::Rules currentRules;
+    quint64 currentSeed;       // generator seed, or library index when puzzleFromLibrary
+    bool puzzleFromLibrary;
+    SudokuPuzzlePool *puzzlePool;
+    SudokuLibrary library;   // mapped; empty when there is no library file
+    SudokuSession session;
+    bool gameInProgress;
+    QFutureWatcher<SudokuVariants::Puzzle> *variantWatcher;
+    bool puzzlePending;   // waiting on the pool or on a variant being generated
+    bool instantSolve;
 
     int selectedRow, selectedCol;
 
@@ -74,8 +133,18 @@ private:
     QPushButton *newGameOverlayButton;
 
     void setupUI();
-    void generatePuzzle(const QString &difficulty);
-    void showWinOverlay(int timeMs);
+    void rebuildKeypad();
+    bool generatePuzzle(const QString &difficulty);
+    void waitForPuzzle(SudokuGenerator::Difficulty level);
+    void generateVariant(SudokuGenerator::Difficulty level);
+    void showPending();
+    void beginPlay(qint64 elapsedMs);
+    void resumeTimer();
+    qint64 playedMs() const;
+    void beginSolving();
+    void showWinOverlay(const QString &message);
+    void showSolverStats(int replayPosition);
+    void placeStatsLabel();
     void hideWinOverlay();
     void setButtonsEnabled(bool enabled);
     void setKeypadEnabled(bool enabled);
@@ -164,6 +164,48 @@ void HomeScreen::setupUI()
     connect(m_difficultyGroup, QOverload<int>::of(&QButtonGroup::idClicked),
             this, &HomeScreen::onDifficultyChanged);
 
+    // Board size radio buttons, id is the box size
+    QHBoxLayout *sizeLayout = new QHBoxLayout();
+    sizeLayout->setSpacing(GameSizes::standardSpacing() * 3);
+    sizeLayout->setAlignment(Qt::AlignCenter);
+
+    m_sizeGroup = new QButtonGroup(this);
+    const QString sizeLabels[] = {"9×9", "16×16", "25×25"};
+    for (int box = 3; box <= 5; ++box) {
+        QRadioButton *rb = new QRadioButton(sizeLabels[box - 3]);
+        rb->setStyleSheet(QString(
+                              "QRadioButton { color: #ecf0f1; font-size: %1px; font-weight: bold; spacing: 12px; background: transparent; }"
+                              "QRadioButton::indicator { width: 16px; height: 16px; }"
+                              "QRadioButton::indicator:checked { background-color: #3498db; border-radius: 8px; }"
+                              ).arg(GameSizes::buttonFontSize() + 2));
+        m_sizeGroup->addButton(rb, box);
+        sizeLayout->addWidget(rb);
+    }
+    m_sizeGroup->button(3)->setChecked(true);
+    mainLayout->addLayout(sizeLayout);
+
+    // Rules radio buttons, id is SudokuVariants::Rules. Variants are 9x9 only.
+    QHBoxLayout *rulesLayout = new QHBoxLayout();
+    rulesLayout->setSpacing(GameSizes::standardSpacing() * 3);
+    rulesLayout->setAlignment(Qt::AlignCenter);
+
+    m_rulesGroup = new QButtonGroup(this);
+    const QString rulesLabels[] = {"CLASSIC", "X", "JIGSAW", "KILLER"};
+    for (int id = 0; id < 4; ++id) {
+        QRadioButton *rb = new QRadioButton(rulesLabels[id]);
+        rb->setStyleSheet(QString(
+                              "QRadioButton { color: #ecf0f1; font-size: %1px; font-weight: bold; spacing: 12px; background: transparent; }"
+                              "QRadioButton::indicator { width: 16px; height: 16px; }"
+                              "QRadioButton::indicator:checked { background-color: #9b59b6; border-radius: 8px; }"
+                              ).arg(GameSizes::buttonFontSize() + 2));
+        m_rulesGroup->addButton(rb, id);
+        rulesLayout->addWidget(rb);
+    }
+    m_rulesGroup->button(0)->setChecked(true);
+    mainLayout->addLayout(rulesLayout);
+    connect(m_rulesGroup, QOverload<int>::of(&QButtonGroup::idClicked),
+            this, &HomeScreen::onRulesChanged);
+
     mainLayout->addStretch();
 
     // Start button
@@ -261,6 +303,25 @@ QString HomeScreen::selectedDifficulty() const
     return "hard";
 }
 
+int HomeScreen::selectedBoxSize() const
+{
+    return m_sizeGroup->checkedId();
+}
+
+SudokuVariants::Rules HomeScreen::selectedRules() const
+{
+    return static_cast<SudokuVariants::Rules>(m_rulesGroup->checkedId());
+}
+
+void HomeScreen::onRulesChanged(int id)
+{
+    bool classic = static_cast<SudokuVariants::Rules>(id) == SudokuVariants::Rules::Classic;
+    if (!classic)
+        m_sizeGroup->button(3)->setChecked(true);
+    for (QAbstractButton *button : m_sizeGroup->buttons())
+        button->setEnabled(classic);
+}
+
 void HomeScreen::updateBestTime(const QString &difficulty, int seconds)
 {
     if (!m_bestTimes.contains(difficulty) || seconds < m_bestTimes[difficulty].seconds) {
@@ -14,6 +14,7 @@
 #include <QKeyEvent>
 #include <QResizeEvent>
 #include <QMap>
+#include "sudokuvariants.h"
 
 struct BestTimeEntry {
     int seconds;
@@ -32,6 +33,8 @@ public:
     void setTitleScale(float scale) { m_titleScale = scale; update(); }
 
     QString selectedDifficulty() const;
+    int selectedBoxSize() const;   // 3, 4 or 5
+    SudokuVariants::Rules selectedRules() const;
     void updateBestTime(const QString &difficulty, int seconds);
 
 signals:
@@ -47,6 +50,7 @@ private slots:
     void onStartClicked();
     void onBackToMenuClicked();  // Changed from onExitClicked
     void onDifficultyChanged(int id);
+    void onRulesChanged(int id);
 
 private:
     void setupUI();
@@ -64,6 +68,8 @@ private:
     QRadioButton *m_easyRadio;
     QRadioButton *m_mediumRadio;
     QRadioButton *m_hardRadio;
+    QButtonGroup *m_sizeGroup;
+    QButtonGroup *m_rulesGroup;
     QPushButton *m_startBtn;
     QPushButton *m_backToMenuBtn;  // Changed from m_exitBtn
     QLabel *m_creditLabel;
@@ -6,6 +6,7 @@
 #include "snake.h"
 #include "minesweeper.h"
 #include "sudokucontroller.h"  // Add Sudoku controller header
+#include "sudokubatch.h"
 
 /**
  * @brief Main Application Entry Point
@@ -15,6 +16,12 @@
  */
 int main(int argc, char *argv[])
 {
+    // Headless batch solving never creates the widgets
+    if (SudokuBatch::requested(argc, argv)) {
+        QCoreApplication app(argc, argv);
+        return SudokuBatch::run(app);
+    }
+
     QApplication a(argc, argv);
 
     // Set Application-Wide Style
@@ -0,0 +1,100 @@
+#include "minefield.h"
+
+/**
+ * @brief Constructs an empty 0x0 board
+ */
+MineField::MineField()
+    : rowCount(0),
+    colCount(0),
+    mines(0),
+    revealedCells(0),
+    flaggedCells(0)
+{
+}
+
+/**
+ * @brief Clears the board
+ */
+void MineField::reset(int rows, int cols)
+{
+    rowCount = rows;
+    colCount = cols;
+    mines = 0;
+    revealedCells = 0;
+    flaggedCells = 0;
+    // assign() reuses the buffer when the size does not grow
+    cells.assign(static_cast<size_t>(rows) * cols, 0);
+}
+
+/**
+ * @brief Places mines and counts them into their neighbours
+ */
+void MineField::placeMines(int count, QRandomGenerator &random)
+{
+    int total = cellCount();
+    count = qMin(count, total);
+    while (mines < count) {
+        int cell = random.bounded(total);
+        if (cells[cell] & Mine) continue;
+        cells[cell] |= Mine;
+        ++mines;
+
+        // Each mine bumps its up-to-eight neighbours; a count never exceeds 8
+        int r = cell / colCount, c = cell % colCount;
+        for (int nr = qMax(0, r - 1); nr <= qMin(rowCount - 1, r + 1); ++nr) {
+            for (int nc = qMax(0, c - 1); nc <= qMin(colCount - 1, c + 1); ++nc) {
+                if (nr != r || nc != c)
+                    ++cells[index(nr, nc)];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Sets or clears the revealed bit, keeping the total in step
+ */
+void MineField::setRevealed(int cell, bool on)
+{
+    if (isRevealed(cell) == on) return;
+    cells[cell] ^= Revealed;
+    revealedCells += on ? 1 : -1;
+}
+
+/**
+ * @brief Sets or clears the flag, keeping the total in step
+ */
+void MineField::setFlagged(int cell, bool on)
+{
+    if (isFlagged(cell) == on) return;
+    cells[cell] ^= Flagged;
+    flaggedCells += on ? 1 : -1;
+}
+
+/**
+ * @brief Opens a cell and floods out from empty ones
+ */
+bool MineField::reveal(int cell, std::vector<int> &opened)
+{
+    opened.clear();
+    if (cells[cell] & (Revealed | Flagged)) return false;
+    setRevealed(cell, true);
+    opened.push_back(cell);
+    if (cells[cell] & Mine) return true;
+
+    // opened doubles as the work list: cells are marked when queued, so
+    // each is visited once and the depth never depends on the board size
+    for (size_t next = 0; next < opened.size(); ++next) {
+        int current = opened[next];
+        if (cells[current] & CountMask) continue;   // numbers stop the flood
+        int r = current / colCount, c = current % colCount;
+        for (int nr = qMax(0, r - 1); nr <= qMin(rowCount - 1, r + 1); ++nr) {
+            for (int nc = qMax(0, c - 1); nc <= qMin(colCount - 1, c + 1); ++nc) {
+                int neighbour = index(nr, nc);
+                if (cells[neighbour] & (Revealed | Flagged | Mine)) continue;
+                setRevealed(neighbour, true);
+                opened.push_back(neighbour);
+            }
+        }
+    }
+    return false;
+}
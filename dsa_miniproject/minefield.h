@@ -0,0 +1,83 @@
+#ifndef MINEFIELD_H
+#define MINEFIELD_H
+
+#include <QRandomGenerator>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class MineField
+ * @brief Minesweeper board state in one contiguous row-major byte array
+ *
+ * Each cell packs its adjacent-mine count (bits 0-3) with the mine,
+ * revealed and flagged bits, so a whole 14x14 board is 196 bytes and any
+ * scan over it (flood fill, win check, hint search) walks memory in order.
+ * The revealed and flagged totals are kept up to date, so the win check and
+ * the mine counter are O(1).
+ */
+class MineField
+{
+public:
+    enum : uint8_t {
+        CountMask = 0x0F,   ///< Adjacent mines, 0-8
+        Mine = 0x10,        ///< Cell holds a mine
+        Revealed = 0x20,    ///< Cell has been opened
+        Flagged = 0x40      ///< Cell carries a flag
+    };
+
+    MineField();
+
+    /**
+     * @brief Clears the board to rows x cols empty, hidden cells
+     */
+    void reset(int rows, int cols);
+
+    /**
+     * @brief Places count mines at random and fills in the neighbour counts
+     * @param count Number of mines, at most the number of cells
+     * @param random Source of randomness
+     */
+    void placeMines(int count, QRandomGenerator &random);
+
+    int rows() const { return rowCount; }
+    int cols() const { return colCount; }
+    int cellCount() const { return static_cast<int>(cells.size()); }
+    int index(int r, int c) const { return r * colCount + c; }
+    bool contains(int r, int c) const { return r >= 0 && r < rowCount && c >= 0 && c < colCount; }
+
+    bool isMine(int cell) const { return cells[cell] & Mine; }
+    bool isRevealed(int cell) const { return cells[cell] & Revealed; }
+    bool isFlagged(int cell) const { return cells[cell] & Flagged; }
+    int adjacentMines(int cell) const { return cells[cell] & CountMask; }
+
+    void setRevealed(int cell, bool on);
+    void setFlagged(int cell, bool on);
+
+    /**
+     * @brief Opens a cell and, if it has no adjacent mines, the whole
+     * surrounding region, without recursion
+     * @param cell Cell to open; flagged or already open cells are left alone
+     * @param opened Receives every newly opened cell, the start first
+     * @return True if the start cell is a mine
+     */
+    bool reveal(int cell, std::vector<int> &opened);
+
+    int revealedCount() const { return revealedCells; }
+    int flaggedCount() const { return flaggedCells; }
+    int mineTotal() const { return mines; }
+
+    /**
+     * @brief The raw packed cells, row-major
+     */
+    const uint8_t *data() const { return cells.data(); }
+
+private:
+    int rowCount;
+    int colCount;
+    int mines;
+    int revealedCells;
+    int flaggedCells;
+    std::vector<uint8_t> cells;
+};
+
+#endif // MINEFIELD_H
@@ -8,6 +8,7 @@
 #include <QFile>
 #include <QTextStream>
 #include <QRandomGenerator>
+#include <QInputDialog>
 
 /**
  * @brief Constructs the MainWindow with a professional dark theme and fixed size
@@ -20,6 +21,9 @@ MainWindow::MainWindow(QWidget *parent)
     m_bestStatBtn(nullptr),
     backButton(nullptr),
     flagsPlaced(0),
+    customRows(100),
+    customCols(100),
+    customMines(1500),
     gamesPlayed(0),
     gamesWon(0),
     secondsElapsed(0),
@@ -135,6 +139,7 @@ MainWindow::MainWindow(QWidget *parent)
     easyBtn = new QPushButton("EASY");
     mediumBtn = new QPushButton("MEDIUM");
     hardBtn = new QPushButton("HARD");
+    customBtn = new QPushButton("CUSTOM");
 
     QString baseButtonStyle =
         "QPushButton {"
@@ -164,32 +169,41 @@ MainWindow::MainWindow(QWidget *parent)
                                                                                      "QPushButton:checked { border: 2px solid white; }"
                            );
 
+    customBtn->setStyleSheet(baseButtonStyle +
+                             "QPushButton { background-color: " + ThemeColors::ACCENT + "; color: " + ThemeColors::DARK_BG + "; }"
+                             "QPushButton:hover { background-color: #d5b4ff; }"
+                             "QPushButton:checked { border: 2px solid white; }"
+                             );
+
     easyBtn->setCheckable(true);
     mediumBtn->setCheckable(true);
     hardBtn->setCheckable(true);
+    customBtn->setCheckable(true);
 
     connect(easyBtn, &QPushButton::clicked, this, &MainWindow::setEasy);
     connect(mediumBtn, &QPushButton::clicked, this, &MainWindow::setMedium);
     connect(hardBtn, &QPushButton::clicked, this, &MainWindow::setHard);
+    connect(customBtn, &QPushButton::clicked, this, &MainWindow::setCustom);
 
     difficultyLayout->addStretch();
     difficultyLayout->addWidget(easyBtn);
     difficultyLayout->addWidget(mediumBtn);
     difficultyLayout->addWidget(hardBtn);
+    difficultyLayout->addWidget(customBtn);
     difficultyLayout->addStretch();
 
     mainLayout->addLayout(difficultyLayout);
     mainLayout->addSpacing(10);
 
-    // ==================== Game Grid Container ====================
-    QWidget *gridContainerWidget = new QWidget();
-    gridContainerWidget->setStyleSheet("background-color: transparent;");
-
-    gridLayout = new QGridLayout(gridContainerWidget);
-    gridLayout->setSpacing(4);
-    gridLayout->setAlignment(Qt::AlignCenter);
+    // ==================== Game Board ====================
+    // One painted widget for any board size; it centres small boards and
+    // scrolls (Ctrl+wheel zooms) large ones
+    boardView = new MineView();
+    boardView->setToolTip("Left click to reveal, right click to flag, Ctrl+wheel to zoom");
+    connect(boardView, &MineView::cellClicked, this, &MainWindow::handleCellClick);
+    connect(boardView, &MineView::cellRightClicked, this, &MainWindow::handleCellRightClick);
 
-    mainLayout->addWidget(gridContainerWidget, 0, Qt::AlignCenter);
+    mainLayout->addWidget(boardView, 1);
 
     // ==================== Bottom Action Buttons ====================
     bottomLayout = new QHBoxLayout();
@@ -262,6 +276,7 @@ void MainWindow::startNewGame()
     easyBtn->setChecked(true);
     mediumBtn->setChecked(false);
     hardBtn->setChecked(false);
+    customBtn->setChecked(false);
     initializeGame();
 }
 
@@ -275,6 +290,7 @@ void MainWindow::setDifficultyAndStart(Difficulty diff)
     easyBtn->setChecked(diff == EASY);
     mediumBtn->setChecked(diff == MEDIUM);
     hardBtn->setChecked(diff == HARD);
+    customBtn->setChecked(diff == CUSTOM);
     initializeGame();
 }
 
@@ -359,6 +375,7 @@ void MainWindow::setupDifficulty(Difficulty diff)
     easyBtn->setChecked(diff == EASY);
     mediumBtn->setChecked(diff == MEDIUM);
     hardBtn->setChecked(diff == HARD);
+    customBtn->setChecked(diff == CUSTOM);
 
     switch(diff) {
     case EASY:
@@ -376,6 +393,11 @@ void MainWindow::setupDifficulty(Difficulty diff)
         cols = 14;
         mineCount = 30;
         break;
+    case CUSTOM:
+        rows = customRows;
+        cols = customCols;
+        mineCount = customMines;
+        break;
     }
 }
 
@@ -395,141 +417,31 @@ void MainWindow::initializeGame()
     restartButton->setText("↻  RESTART");
     moveHistory.clear();
 
-    // Clear existing grid
-    QLayoutItem *child;
-    while ((child = gridLayout->takeAt(0)) != nullptr) {
-        delete child->widget();
-        delete child;
-    }
-
-    buttons.clear();
-    board.clear();
-    revealed.clear();
-    flagged.clear();
-
-    buttons.resize(rows);
-    board.resize(rows);
-    revealed.resize(rows);
-    flagged.resize(rows);
-
-    int buttonSize;
-    if (rows <= 6) buttonSize = 70;
-    else if (rows <= 10) buttonSize = 55;
-    else buttonSize = 45;
-
-    for(int r = 0; r < rows; r++) {
-        buttons[r].resize(cols);
-        board[r].resize(cols);
-        revealed[r].resize(cols);
-        flagged[r].resize(cols);
-
-        for(int c = 0; c < cols; c++) {
-            board[r][c] = 0;
-            revealed[r][c] = false;
-            flagged[r][c] = false;
-        }
+    field.reset(rows, cols);
 
-        for(int c = 0; c < cols; c++) {
-            QPushButton *btn = new QPushButton("");
-            btn->setFixedSize(buttonSize, buttonSize);
-
-            int fontSize = buttonSize >= 70 ? 18 : (buttonSize >= 55 ? 16 : 14);
-            btn->setFont(QFont("Segoe UI", fontSize, QFont::Bold));
-
-            btn->setStyleSheet(
-                "QPushButton {"
-                "   background-color: " + ThemeColors::SURFACE + ";"
-                                         "   border: 1px solid " + ThemeColors::BORDER + ";"
-                                        "   border-radius: " + QString::number(buttonSize/8) + "px;"
-                                                    "   color: " + ThemeColors::TEXT + ";"
-                                      "}"
-                                      "QPushButton:hover {"
-                                      "   background-color: " + ThemeColors::HOVER + ";"
-                                       "   border-color: " + ThemeColors::PRIMARY + ";"
-                                         "}"
-                                         "QPushButton:disabled {"
-                                         "   background-color: " + ThemeColors::DARKER_BG + ";"
-                                           "   border-color: " + ThemeColors::BORDER + ";"
-                                        "}"
-                );
-
-            // Individual button shadows removed to prevent painter conflicts
-
-            gridLayout->addWidget(btn, r, c);
-            buttons[r][c] = btn;
-
-            connect(btn, &QPushButton::clicked, this, &MainWindow::handleCellClick);
-            btn->setContextMenuPolicy(Qt::CustomContextMenu);
-            connect(btn, &QPushButton::customContextMenuRequested, this, &MainWindow::handleCellRightClick);
-        }
-    }
+    // The presets keep their old button sizes (plus the 4px spacing); custom
+    // boards fit the view when they can and otherwise start at a playable size
+    int cellSize;
+    if(difficulty == CUSTOM) {
+        QSize area = boardView->viewport()->size();
+        cellSize = qBound(16, qMin(area.width() / cols, area.height() / rows), 49);
+    } else if (rows <= 6) cellSize = 74;
+    else if (rows <= 10) cellSize = 59;
+    else cellSize = 49;
 
-    placeMines();
-    calculateNumbers();
+    field.placeMines(mineCount, *QRandomGenerator::global());
+    boardView->setField(&field, cellSize);
     timer->start(1000);
 }
 
-/**
- * @brief Places mines randomly on the board
- */
-void MainWindow::placeMines()
-{
-    int placed = 0;
-    while(placed < mineCount) {
-        int r = QRandomGenerator::global()->bounded(rows);
-        int c = QRandomGenerator::global()->bounded(cols);
-        if(board[r][c] != -1) {
-            board[r][c] = -1;
-            placed++;
-        }
-    }
-}
-
-/**
- * @brief Calculates adjacent mine counts
- */
-void MainWindow::calculateNumbers()
-{
-    for(int r = 0; r < rows; r++) {
-        for(int c = 0; c < cols; c++) {
-            if(board[r][c] == -1) continue;
-
-            int count = 0;
-            for(int i = -1; i <= 1; i++) {
-                for(int j = -1; j <= 1; j++) {
-                    int nr = r + i, nc = c + j;
-                    if(nr >= 0 && nr < rows && nc >= 0 && nc < cols && board[nr][nc] == -1)
-                        count++;
-                }
-            }
-            board[r][c] = count;
-        }
-    }
-}
-
 /**
  * @brief Handles left-click on a cell
  */
-void MainWindow::handleCellClick()
+void MainWindow::handleCellClick(int cell)
 {
-    QPushButton *btn = qobject_cast<QPushButton*>(sender());
-    if (!btn) return;
-
-    animateButton(btn);
-
-    int r = -1, c = -1;
-    for(int i = 0; i < rows; i++) {
-        for(int j = 0; j < cols; j++) {
-            if(buttons[i][j] == btn) {
-                r = i;
-                c = j;
-                break;
-            }
-        }
-    }
-
-    if(r == -1 || flagged[r][c] || revealed[r][c]) return;
+    if(field.isFlagged(cell) || field.isRevealed(cell)) return;
 
+    int r = cell / cols, c = cell % cols;
     revealCell(r, c);
     Move move;
     move.r = r;
@@ -541,49 +453,14 @@ void MainWindow::handleCellClick()
 /**
  * @brief Handles right-click (flagging) on a cell
  */
-void MainWindow::handleCellRightClick(const QPoint &)
+void MainWindow::handleCellRightClick(int cell)
 {
-    QPushButton *btn = qobject_cast<QPushButton*>(sender());
-    if (!btn) return;
-
-    animateButton(btn);
+    if(field.isRevealed(cell)) return;
 
-    int r = -1, c = -1;
-    for(int i = 0; i < rows; i++) {
-        for(int j = 0; j < cols; j++) {
-            if(buttons[i][j] == btn) {
-                r = i;
-                c = j;
-                break;
-            }
-        }
-    }
-
-    if(r == -1 || revealed[r][c]) return;
-
-    if(flagged[r][c]) {
-        flagged[r][c] = false;
-        flagsPlaced--;
-        btn->setText("");
-        btn->setStyleSheet(
-            "QPushButton { background-color: " + ThemeColors::SURFACE +
-            "; border: 1px solid " + ThemeColors::BORDER +
-            "; border-radius: " + QString::number(btn->width()/8) + "px;"
-                                                                      " color: " + ThemeColors::TEXT + "; }"
-                                  "QPushButton:hover { background-color: " + ThemeColors::HOVER + "; border-color: " + ThemeColors::PRIMARY + "; }"
-            );
-    } else {
-        flagged[r][c] = true;
-        flagsPlaced++;
-        btn->setText("🚩");
-        btn->setStyleSheet(
-            "QPushButton { background-color: " + ThemeColors::SURFACE +
-            "; border: 1px solid " + ThemeColors::ERROR +
-            "; border-radius: " + QString::number(btn->width()/8) + "px;"
-                                                                      " color: " + ThemeColors::ERROR + "; }"
-                                   "QPushButton:hover { background-color: " + ThemeColors::HOVER + "; }"
-            );
-    }
+    bool flag = !field.isFlagged(cell);
+    field.setFlagged(cell, flag);
+    flagsPlaced += flag ? 1 : -1;
+    boardView->updateCell(cell);
 
     m_mineStatBtn->setText("💣  " + QString::number(mineCount - flagsPlaced));
 }
@@ -593,62 +470,18 @@ void MainWindow::handleCellRightClick(const QPoint &)
  */
 void MainWindow::revealCell(int r, int c)
 {
-    if(r < 0 || r >= rows || c < 0 || c >= cols) return;
-    if(revealed[r][c]) return;
-    if(flagged[r][c]) return;
-
-    revealed[r][c] = true;
-
-    if(board[r][c] == -1) {
-        buttons[r][c]->setText("💣");
-        buttons[r][c]->setStyleSheet(
-            "QPushButton { background-color: " + ThemeColors::ERROR +
-            "; border: 1px solid " + ThemeColors::ERROR +
-            "; border-radius: " + QString::number(buttons[r][c]->width()/8) + "px;"
-                                                                                " color: white; }"
-            );
+    if(!field.contains(r, c)) return;
+
+    // The field works out the whole reveal set first, without recursion
+    if(field.reveal(field.index(r, c), opened)) {
+        boardView->setOutcome(MineView::Outcome::Lost, opened.front());
         restartButton->setText("😵  RESTART");
         gameOver(false);
         return;
     }
 
-    if(board[r][c] > 0) {
-        QString numberColor;
-        switch(board[r][c]) {
-        case 1: numberColor = "#89b4fa"; break;
-        case 2: numberColor = "#a6e3a1"; break;
-        case 3: numberColor = "#f38ba8"; break;
-        case 4: numberColor = "#cba6f7"; break;
-        case 5: numberColor = "#fab387"; break;
-        default: numberColor = "#94e2d5"; break;
-        }
-
-        buttons[r][c]->setText(QString::number(board[r][c]));
-        buttons[r][c]->setStyleSheet(
-            "QPushButton { background-color: " + ThemeColors::DARKER_BG +
-            "; border: 1px solid " + ThemeColors::BORDER +
-            "; border-radius: " + QString::number(buttons[r][c]->width()/8) + "px;"
-                                                                                " color: " + numberColor + "; }"
-            );
-    } else {
-        buttons[r][c]->setText("");
-        buttons[r][c]->setStyleSheet(
-            "QPushButton { background-color: " + ThemeColors::DARKER_BG +
-            "; border: 1px solid " + ThemeColors::BORDER +
-            "; border-radius: " + QString::number(buttons[r][c]->width()/8) + "px;"
-                                                                                " color: " + ThemeColors::TEXT + "; }"
-            );
-
-        for(int i = -1; i <= 1; i++) {
-            for(int j = -1; j <= 1; j++) {
-                int nr = r + i, nc = c + j;
-                if(nr >= 0 && nr < rows && nc >= 0 && nc < cols && !flagged[nr][nc] && !revealed[nr][nc])
-                    revealCell(nr, nc);
-            }
-        }
-    }
-
-    buttons[r][c]->setEnabled(false);
+    // Then the view repaints just those cells, or itself once for a big region
+    boardView->updateCells(opened);
 }
 
 /**
@@ -656,23 +489,13 @@ void MainWindow::revealCell(int r, int c)
  */
 void MainWindow::checkWin()
 {
-    int revealedCount = 0;
-    for(int r = 0; r < rows; r++) {
-        for(int c = 0; c < cols; c++) {
-            if(revealed[r][c]) revealedCount++;
-        }
-    }
-
-    if(revealedCount == (rows * cols - mineCount)) {
+    // The field keeps the revealed total, so no scan
+    if(field.revealedCount() == field.cellCount() - field.mineTotal()) {
         timer->stop();
         restartButton->setText("🏆  RESTART");
 
-        for(int r = 0; r < rows; r++) {
-            for(int c = 0; c < cols; c++) {
-                if(board[r][c] == -1 && !flagged[r][c])
-                    buttons[r][c]->setText("🚩");
-            }
-        }
+        // The view flags the remaining mines itself
+        boardView->setOutcome(MineView::Outcome::Won);
 
         saveBestScore(secondsElapsed);
         saveStatistics(true);
@@ -697,13 +520,11 @@ void MainWindow::gameOver(bool win)
     timer->stop();
     saveStatistics(false);
 
-    for(int r = 0; r < rows; r++) {
-        for(int c = 0; c < cols; c++) {
-            buttons[r][c]->setEnabled(false);
-            if(board[r][c] == -1 && !flagged[r][c])
-                buttons[r][c]->setText("💣");
-        }
-    }
+    // Ending the view's game stops its input and shows the mines
+    if(win)
+        boardView->setOutcome(MineView::Outcome::Won);
+    else if(boardView->gameOutcome() == MineView::Outcome::Playing)
+        boardView->setOutcome(MineView::Outcome::Lost);
 
     if(!win) {
         QMessageBox msgBox(this);
@@ -725,21 +546,13 @@ void MainWindow::giveHint()
 {
     int r, c;
     if(safeCell(r, c)) {
-        QString originalStyle = buttons[r][c]->styleSheet();
+        int cell = field.index(r, c);
+        // On a large board the safe cell may be scrolled out of sight
+        boardView->scrollToCell(cell);
+        boardView->setHighlight(cell);
 
-        buttons[r][c]->setStyleSheet(
-            "QPushButton { background-color: " + ThemeColors::WARNING +
-            "; border: 2px solid " + ThemeColors::WARNING +
-            "; border-radius: " + QString::number(buttons[r][c]->width()/8) + "px;"
-                                                                                " color: " + ThemeColors::DARK_BG + "; }"
-            );
-
-        QTimer::singleShot(500, [this, r, c, originalStyle]() {
-            if(r >= 0 && r < rows && c >= 0 && c < cols) {
-                if(!revealed[r][c] && !flagged[r][c]) {
-                    buttons[r][c]->setStyleSheet(originalStyle);
-                }
-            }
+        QTimer::singleShot(500, this, [this]() {
+            boardView->setHighlight(-1);
         });
     }
 }
@@ -749,13 +562,13 @@ void MainWindow::giveHint()
  */
 bool MainWindow::safeCell(int &r, int &c)
 {
-    for(int i = 0; i < rows; i++) {
-        for(int j = 0; j < cols; j++) {
-            if(!revealed[i][j] && !flagged[i][j] && board[i][j] != -1) {
-                r = i;
-                c = j;
-                return true;
-            }
+    // One pass over the packed cells: hidden, unflagged and not a mine
+    const uint8_t *cells = field.data();
+    for(int cell = 0; cell < field.cellCount(); cell++) {
+        if(!(cells[cell] & (MineField::Revealed | MineField::Flagged | MineField::Mine))) {
+            r = cell / cols;
+            c = cell % cols;
+            return true;
         }
     }
     return false;
@@ -769,37 +582,13 @@ void MainWindow::undoLastMove()
     if(moveHistory.isEmpty()) return;
     Move last = moveHistory.takeLast();
 
-    if(last.r >= 0 && last.r < rows && last.c >= 0 && last.c < cols) {
-        revealed[last.r][last.c] = false;
-        buttons[last.r][last.c]->setEnabled(true);
-        buttons[last.r][last.c]->setText("");
-        buttons[last.r][last.c]->setStyleSheet(
-            "QPushButton { background-color: " + ThemeColors::SURFACE +
-            "; border: 1px solid " + ThemeColors::BORDER +
-            "; border-radius: " + QString::number(buttons[last.r][last.c]->width()/8) + "px;"
-                                                                                          " color: " + ThemeColors::TEXT + "; }"
-                                  "QPushButton:hover { background-color: " + ThemeColors::HOVER + "; border-color: " + ThemeColors::PRIMARY + "; }"
-            );
+    if(field.contains(last.r, last.c)) {
+        int cell = field.index(last.r, last.c);
+        field.setRevealed(cell, false);
+        boardView->updateCell(cell);
     }
 }
 
-/**
- * @brief Animates button press
- */
-void MainWindow::animateButton(QPushButton* btn)
-{
-    if (!btn) return;
-
-    QPropertyAnimation *animation = new QPropertyAnimation(btn, "geometry");
-    animation->setDuration(100);
-    animation->setStartValue(btn->geometry());
-    QRect endRect = btn->geometry();
-    endRect.setSize(endRect.size() * 0.95);
-    animation->setEndValue(endRect);
-    animation->setEasingCurve(QEasingCurve::OutQuad);
-    animation->start(QPropertyAnimation::DeleteWhenStopped);
-}
-
 /**
  * @brief Updates timer display
  */
@@ -931,3 +720,26 @@ void MainWindow::setHard()
     setupDifficulty(HARD);
     initializeGame();
 }
+
+/**
+ * @brief Sets a custom board after asking for its size
+ */
+void MainWindow::setCustom()
+{
+    bool ok = false;
+    int height = QInputDialog::getInt(this, "Custom Board", "Rows:", customRows, 2, 2000, 1, &ok);
+    int width = ok ? QInputDialog::getInt(this, "Custom Board", "Columns:", customCols, 2, 2000, 1, &ok) : 0;
+    int mines = ok ? QInputDialog::getInt(this, "Custom Board", "Mines:",
+                                          qMin(customMines, height * width - 1), 1, height * width - 1, 1, &ok) : 0;
+    if(!ok) {
+        // Cancelled: stay on the board being played
+        customBtn->setChecked(difficulty == CUSTOM);
+        return;
+    }
+
+    customRows = height;
+    customCols = width;
+    customMines = mines;
+    setupDifficulty(CUSTOM);
+    initializeGame();
+}
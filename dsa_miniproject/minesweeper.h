@@ -22,6 +22,8 @@
 #include <QScrollArea>
 #include <QEasingCurve>
 #include <QGraphicsDropShadowEffect>
+#include "minefield.h"
+#include "mineview.h"
 
 /**
  * @enum Difficulty
@@ -30,7 +32,8 @@
 enum Difficulty {
     EASY,      ///< Easy difficulty - 6x6 grid with 6 mines
     MEDIUM,    ///< Medium difficulty - 10x10 grid with 15 mines
-    HARD       ///< Hard difficulty - 14x14 grid with 30 mines
+    HARD,      ///< Hard difficulty - 14x14 grid with 30 mines
+    CUSTOM     ///< Player-chosen size and mine count, up to 2000x2000
 };
 
 /**
@@ -120,14 +123,15 @@ private slots:
 
     /**
      * @brief Handles left-click on a cell
+     * @param cell Row-major cell index
      */
-    void handleCellClick();
+    void handleCellClick(int cell);
 
     /**
      * @brief Handles right-click (flagging) on a cell
-     * @param pos Mouse position (unused)
+     * @param cell Row-major cell index
      */
-    void handleCellRightClick(const QPoint &pos);
+    void handleCellRightClick(int cell);
 
     /**
      * @brief Sets game to Easy difficulty
@@ -144,6 +148,11 @@ private slots:
      */
     void setHard();
 
+    /**
+     * @brief Asks for a board size and mine count and starts that game
+     */
+    void setCustom();
+
     /**
      * @brief Provides a hint by highlighting a safe cell
      */
@@ -154,12 +163,6 @@ private slots:
      */
     void undoLastMove();
 
-    /**
-     * @brief Animates button press
-     * @param btn Button to animate
-     */
-    void animateButton(QPushButton* btn);
-
     /**
      * @brief Displays game statistics
      */
@@ -170,7 +173,7 @@ private:
     QWidget *centralWidget;              ///< Central widget
     QVBoxLayout *mainLayout;             ///< Main vertical layout
     QHBoxLayout *topLayout;              ///< Top layout for stats
-    QGridLayout *gridLayout;              ///< Grid layout for game board
+    MineView *boardView;                  ///< Painted, scrollable game board
     QHBoxLayout *bottomLayout;            ///< Bottom layout for action buttons
     QHBoxLayout *statsLayout;             ///< Statistics layout
 
@@ -187,16 +190,14 @@ private:
     QPushButton *easyBtn;                  ///< Easy difficulty button
     QPushButton *mediumBtn;                 ///< Medium difficulty button
     QPushButton *hardBtn;                   ///< Hard difficulty button
+    QPushButton *customBtn;                 ///< Custom board button
     QPushButton *hintBtn;                   ///< Hint button
     QPushButton *undoBtn;                   ///< Undo button
     QPushButton *statsBtn;                  ///< Statistics button
     QPushButton *backButton;                ///< Back to main menu button
 
     // Game Board Data
-    QVector<QVector<QPushButton*>> buttons;  ///< 2D array of cell buttons
-    QVector<QVector<int>> board;              ///< Game board state (-1 for mine, 0-8 for adjacent mines)
-    QVector<QVector<bool>> revealed;          ///< Whether each cell is revealed
-    QVector<QVector<bool>> flagged;           ///< Whether each cell is flagged
+    MineField field;                          ///< Packed cell state: mine, count, revealed, flagged
 
     // Game State
     QTimer *timer;                            ///< Game timer
@@ -206,6 +207,9 @@ private:
     int mineCount;                             ///< Number of mines in current game
     int flagsPlaced;                           ///< Number of flags placed
     Difficulty difficulty;                      ///< Current difficulty level
+    int customRows;                            ///< Last custom board height
+    int customCols;                            ///< Last custom board width
+    int customMines;                           ///< Last custom mine count
 
     // Statistics
     int bestTime;                              ///< Best time record
@@ -217,6 +221,9 @@ private:
     // Move History
     QVector<Move> moveHistory;                 ///< History of moves for undo
 
+    // Reveal
+    std::vector<int> opened;                   ///< Cells opened by the last reveal, reused between clicks
+
     // ==================== Private Methods ====================
     /**
      * @brief Initializes a new game
@@ -230,17 +237,7 @@ private:
     void setupDifficulty(Difficulty diff);
 
     /**
-     * @brief Randomly places mines on the board
-     */
-    void placeMines();
-
-    /**
-     * @brief Calculates adjacent mine counts for each cell
-     */
-    void calculateNumbers();
-
-    /**
-     * @brief Reveals a cell and handles cascading reveals
+     * @brief Reveals a cell and, for an empty one, its whole region
      * @param r Row coordinate
      * @param c Column coordinate
      */
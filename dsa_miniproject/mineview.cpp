@@ -0,0 +1,410 @@
+#include "mineview.h"
+#include "minefield.h"
+#include "minesweeper.h"
+#include <QMouseEvent>
+#include <QPaintEvent>
+#include <QPainter>
+#include <QScrollBar>
+#include <QWheelEvent>
+#include <cmath>
+
+namespace {
+
+// Below these sizes borders, rounding and text (then the gaps) are dropped
+const int DetailCellSize = 12;
+const int GapCellSize = 6;
+
+// Digit colours by adjacent mine count; 0 is never drawn
+const QColor NumberColors[9] = {
+    QColor(ThemeColors::TEXT), QColor("#89b4fa"), QColor("#a6e3a1"), QColor("#f38ba8"),
+    QColor("#cba6f7"), QColor("#fab387"), QColor("#94e2d5"), QColor("#94e2d5"), QColor("#94e2d5")
+};
+const QString Digits[9] = { "", "1", "2", "3", "4", "5", "6", "7", "8" };
+const QString FlagText = "🚩";
+const QString MineText = "💣";
+
+} // namespace
+
+/**
+ * @brief Constructs an empty view; nothing is drawn until setField()
+ */
+MineView::MineView(QWidget *parent)
+    : QAbstractScrollArea(parent),
+    field(nullptr),
+    side(45),
+    gap(4),
+    outcome(Outcome::Playing),
+    exploded(-1),
+    highlighted(-1),
+    hovered(-1)
+{
+    setFrameShape(QFrame::NoFrame);
+    setStyleSheet("QAbstractScrollArea { background-color: transparent; }");
+    viewport()->setAttribute(Qt::WA_OpaquePaintEvent);
+    viewport()->setMouseTracking(true);
+    viewport()->setCursor(Qt::PointingHandCursor);
+    numberFont = QFont("Segoe UI");
+    numberFont.setBold(true);
+}
+
+/**
+ * @brief Shows a new board from its top-left corner
+ */
+void MineView::setField(const MineField *newField, int cellSize)
+{
+    field = newField;
+    outcome = Outcome::Playing;
+    exploded = -1;
+    highlighted = -1;
+    hovered = -1;
+    setCellSize(cellSize);
+    horizontalScrollBar()->setValue(0);
+    verticalScrollBar()->setValue(0);
+    viewport()->update();
+}
+
+/**
+ * @brief Changes the zoom; the scroll position is left to the caller
+ */
+void MineView::setCellSize(int size)
+{
+    side = qBound(MinCellSize, size, MaxCellSize);
+    gap = side >= DetailCellSize ? qMax(2, side / 16) : (side >= GapCellSize ? 1 : 0);
+    numberFont.setPixelSize(qMax(6, side * 2 / 5));
+    updateScrollBars();
+    viewport()->update();
+}
+
+/**
+ * @brief Records how the game ended and repaints the board once
+ */
+void MineView::setOutcome(Outcome newOutcome, int explodedCell)
+{
+    outcome = newOutcome;
+    exploded = explodedCell;
+    hovered = -1;
+    viewport()->update();
+}
+
+/**
+ * @brief Moves the hint highlight, repainting the old and new cells only
+ */
+void MineView::setHighlight(int cell)
+{
+    if(cell == highlighted) return;
+    updateCell(highlighted);
+    highlighted = cell;
+    updateCell(highlighted);
+}
+
+/**
+ * @brief Brings a cell into view, centred, unless it already is
+ */
+void MineView::scrollToCell(int cell)
+{
+    if(!field || cell < 0 || cell >= field->cellCount()) return;
+    if(viewport()->rect().contains(cellRect(cell))) return;
+    int r = cell / field->cols(), c = cell % field->cols();
+    horizontalScrollBar()->setValue(c * side + side / 2 - viewport()->width() / 2);
+    verticalScrollBar()->setValue(r * side + side / 2 - viewport()->height() / 2);
+}
+
+/**
+ * @brief Repaints a batch of cells
+ */
+void MineView::updateCells(const std::vector<int> &cells)
+{
+    // Past a few hundred rectangles one full repaint is cheaper than the region
+    if(cells.size() > 256) {
+        viewport()->update();
+        return;
+    }
+    for(int cell : cells)
+        updateCell(cell);
+}
+
+/**
+ * @brief Repaints one cell if it is on screen
+ */
+void MineView::updateCell(int cell)
+{
+    if(!field || cell < 0 || cell >= field->cellCount()) return;
+    QRect rect = cellRect(cell).intersected(viewport()->rect());
+    if(!rect.isEmpty())
+        viewport()->update(rect);
+}
+
+/**
+ * @brief Viewport position of the board's top-left corner
+ *
+ * A board smaller than the viewport is centred; a larger one scrolls.
+ */
+QPoint MineView::origin() const
+{
+    if(!field) return QPoint();
+    int width = field->cols() * side - gap;
+    int height = field->rows() * side - gap;
+    int x = width < viewport()->width() ? (viewport()->width() - width) / 2 : -horizontalScrollBar()->value();
+    int y = height < viewport()->height() ? (viewport()->height() - height) / 2 : -verticalScrollBar()->value();
+    return QPoint(x, y);
+}
+
+/**
+ * @brief Viewport rectangle of a cell, gap included
+ */
+QRect MineView::cellRect(int cell) const
+{
+    int r = cell / field->cols(), c = cell % field->cols();
+    return QRect(origin() + QPoint(c * side, r * side), QSize(side, side));
+}
+
+/**
+ * @brief Cell under a viewport position, or -1 for none
+ */
+int MineView::cellAt(const QPoint &pos) const
+{
+    if(!field) return -1;
+    QPoint p = pos - origin();
+    if(p.x() < 0 || p.y() < 0) return -1;
+    int r = p.y() / side, c = p.x() / side;
+    if(!field->contains(r, c)) return -1;
+    return field->index(r, c);
+}
+
+/**
+ * @brief Sizes the scroll bars to the board at the current zoom
+ */
+void MineView::updateScrollBars()
+{
+    int width = field ? field->cols() * side - gap : 0;
+    int height = field ? field->rows() * side - gap : 0;
+    QSize area = viewport()->size();
+    horizontalScrollBar()->setRange(0, qMax(0, width - area.width()));
+    verticalScrollBar()->setRange(0, qMax(0, height - area.height()));
+    horizontalScrollBar()->setPageStep(area.width());
+    verticalScrollBar()->setPageStep(area.height());
+    horizontalScrollBar()->setSingleStep(side);
+    verticalScrollBar()->setSingleStep(side);
+}
+
+/**
+ * @brief Moves the hover mark, repainting the two cells involved
+ */
+void MineView::setHovered(int cell)
+{
+    if(cell == hovered) return;
+    updateCell(hovered);
+    hovered = cell;
+    updateCell(hovered);
+}
+
+/**
+ * @brief Paints the cells under the dirty rectangle
+ */
+void MineView::paintEvent(QPaintEvent *event)
+{
+    QPainter painter(viewport());
+    QRect dirty = event->rect();
+    painter.fillRect(dirty, QColor(ThemeColors::DARK_BG));
+    if(!field || field->cellCount() == 0) return;
+
+    // Only rows and columns that touch the dirty rectangle are visited
+    QPoint o = origin();
+    int left = dirty.left() - o.x(), top = dirty.top() - o.y();
+    int right = dirty.right() - o.x(), bottom = dirty.bottom() - o.y();
+    if(right < 0 || bottom < 0) return;
+    int firstCol = qMax(0, left / side), lastCol = qMin(field->cols() - 1, right / side);
+    int firstRow = qMax(0, top / side), lastRow = qMin(field->rows() - 1, bottom / side);
+    if(firstCol > lastCol || firstRow > lastRow) return;
+
+    if(gap == 0)
+        paintOverview(painter, firstRow, lastRow, firstCol, lastCol);
+    else
+        paintCells(painter, firstRow, lastRow, firstCol, lastCol);
+}
+
+/**
+ * @brief Draws cells one by one, with text once they are large enough
+ */
+void MineView::paintCells(QPainter &painter, int firstRow, int lastRow, int firstCol, int lastCol)
+{
+    const QColor surface(ThemeColors::SURFACE), border(ThemeColors::BORDER);
+    const QColor open(ThemeColors::DARKER_BG), hover(ThemeColors::HOVER);
+    const QColor primary(ThemeColors::PRIMARY), error(ThemeColors::ERROR);
+    const QColor warning(ThemeColors::WARNING), text(ThemeColors::TEXT);
+
+    bool detailed = side >= DetailCellSize;
+    qreal radius = side / 8.0;
+    if(detailed) {
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setFont(numberFont);
+    }
+    painter.setPen(Qt::NoPen);
+
+    const uint8_t *cells = field->data();
+    QPoint o = origin();
+    for(int r = firstRow; r <= lastRow; r++) {
+        for(int c = firstCol; c <= lastCol; c++) {
+            int cell = field->index(r, c);
+            uint8_t bits = cells[cell];
+            QRectF box(o.x() + c * side, o.y() + r * side, side - gap, side - gap);
+
+            QColor fill = surface, edge = border, ink = text;
+            const QString *label = nullptr;
+            if(cell == exploded) {
+                fill = edge = error;
+                ink = Qt::white;
+                label = &MineText;
+            } else if(bits & MineField::Revealed) {
+                int adjacent = bits & MineField::CountMask;
+                fill = open;
+                ink = NumberColors[adjacent];
+                label = &Digits[adjacent];
+            } else if(cell == highlighted) {
+                fill = edge = warning;
+            } else if(bits & MineField::Flagged) {
+                edge = ink = error;
+                label = &FlagText;
+            } else if((bits & MineField::Mine) && outcome != Outcome::Playing) {
+                // A won board flags the leftover mines, a lost one shows them
+                label = outcome == Outcome::Won ? &FlagText : &MineText;
+                if(outcome == Outcome::Won) ink = error;
+            } else if(cell == hovered && outcome == Outcome::Playing) {
+                fill = hover;
+                edge = primary;
+            }
+
+            if(!detailed) {
+                // Too small for text: flags and mines become solid cells
+                if(label == &FlagText || label == &MineText) fill = error;
+                else if(label && !label->isEmpty()) fill = ink.darker(200);
+                painter.fillRect(box, fill);
+                continue;
+            }
+
+            painter.setBrush(edge);
+            painter.drawRoundedRect(box, radius, radius);
+            painter.setBrush(fill);
+            painter.drawRoundedRect(box.adjusted(1, 1, -1, -1), radius, radius);
+            if(label && !label->isEmpty()) {
+                painter.setPen(ink);
+                painter.drawText(box, Qt::AlignCenter, *label);
+                painter.setPen(Qt::NoPen);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Draws the visible cells as one pixel each and scales them up
+ *
+ * At a few pixels per cell a fillRect per cell costs more than the pixels it
+ * covers; one write per cell into an image the size of the visible block and
+ * a single scaled blit keeps the frame time flat.
+ */
+void MineView::paintOverview(QPainter &painter, int firstRow, int lastRow, int firstCol, int lastCol)
+{
+    const QRgb surface = QColor(ThemeColors::SURFACE).rgb(), open = QColor(ThemeColors::DARKER_BG).rgb();
+    const QRgb error = QColor(ThemeColors::ERROR).rgb(), warning = QColor(ThemeColors::WARNING).rgb();
+    QRgb numbers[9];
+    for(int n = 0; n < 9; n++)
+        numbers[n] = n == 0 ? open : NumberColors[n].darker(200).rgb();
+
+    int width = lastCol - firstCol + 1, height = lastRow - firstRow + 1;
+    if(overview.width() < width || overview.height() < height)
+        overview = QImage(qMax(width, overview.width()), qMax(height, overview.height()), QImage::Format_RGB32);
+
+    const uint8_t *cells = field->data();
+    for(int r = firstRow; r <= lastRow; r++) {
+        QRgb *line = reinterpret_cast<QRgb *>(overview.scanLine(r - firstRow));
+        const uint8_t *row = cells + field->index(r, firstCol);
+        for(int c = 0; c < width; c++) {
+            uint8_t bits = row[c];
+            int cell = field->index(r, firstCol + c);
+            QRgb colour = surface;
+            if(bits & MineField::Revealed)
+                colour = (bits & MineField::Mine) ? error : numbers[bits & MineField::CountMask];
+            else if(cell == highlighted)
+                colour = warning;
+            else if((bits & MineField::Flagged) || ((bits & MineField::Mine) && outcome != Outcome::Playing))
+                colour = error;
+            line[c] = colour;
+        }
+    }
+
+    QPoint o = origin();
+    QRect target(o.x() + firstCol * side, o.y() + firstRow * side, width * side, height * side);
+    painter.drawImage(target, overview, QRect(0, 0, width, height));
+}
+
+/**
+ * @brief Keeps the scroll ranges in step with the viewport size
+ */
+void MineView::resizeEvent(QResizeEvent *event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBars();
+}
+
+/**
+ * @brief Maps a click to a cell by arithmetic on the scrolled position
+ */
+void MineView::mousePressEvent(QMouseEvent *event)
+{
+    int cell = cellAt(event->position().toPoint());
+    if(cell < 0 || outcome != Outcome::Playing) return;
+    if(event->button() == Qt::LeftButton)
+        emit cellClicked(cell);
+    else if(event->button() == Qt::RightButton)
+        emit cellRightClicked(cell);
+}
+
+/**
+ * @brief Tracks the cell under the pointer for the hover colour
+ */
+void MineView::mouseMoveEvent(QMouseEvent *event)
+{
+    if(outcome == Outcome::Playing)
+        setHovered(cellAt(event->position().toPoint()));
+}
+
+/**
+ * @brief Clears the hover mark when the pointer leaves the board
+ */
+bool MineView::viewportEvent(QEvent *event)
+{
+    if(event->type() == QEvent::Leave)
+        setHovered(-1);
+    return QAbstractScrollArea::viewportEvent(event);
+}
+
+/**
+ * @brief Ctrl+wheel zooms about the pointer; a plain wheel scrolls
+ */
+void MineView::wheelEvent(QWheelEvent *event)
+{
+    if(!(event->modifiers() & Qt::ControlModifier) || !field) {
+        QAbstractScrollArea::wheelEvent(event);
+        return;
+    }
+    int steps = event->angleDelta().y() / 120;
+    if(steps == 0) return;
+
+    // Remember which board point is under the pointer, zoom, then scroll it back
+    QPointF pos = event->position();
+    QPointF board = (pos - QPointF(origin())) / side;
+    int size = steps > 0 ? qMax(side + 1, int(std::lround(side * 1.25)))
+                         : qMin(side - 1, int(std::lround(side / 1.25)));
+    setCellSize(size);
+    horizontalScrollBar()->setValue(int(std::lround(board.x() * side - pos.x())));
+    verticalScrollBar()->setValue(int(std::lround(board.y() * side - pos.y())));
+    event->accept();
+}
+
+/**
+ * @brief Shifts the pixels already drawn and paints only the exposed strip
+ */
+void MineView::scrollContentsBy(int dx, int dy)
+{
+    viewport()->scroll(dx, dy);
+}
@@ -0,0 +1,104 @@
+#ifndef MINEVIEW_H
+#define MINEVIEW_H
+
+#include <QAbstractScrollArea>
+#include <QFont>
+#include <QImage>
+#include <vector>
+
+class MineField;
+class QPainter;
+
+/**
+ * @class MineView
+ * @brief Scrollable, zoomable view of a MineField, painted directly
+ *
+ * There are no per-cell widgets: each paint walks only the rows and columns
+ * that intersect the dirty part of the viewport and reads them straight from
+ * the field, so the cost of a frame depends on the window size and not on
+ * the board size. A click maps to a cell by dividing the scrolled position
+ * by the cell size. Ctrl+wheel zooms around the mouse pointer; below a few
+ * pixels per cell the visible part is drawn as one small image, one pixel per
+ * cell, scaled up.
+ */
+class MineView : public QAbstractScrollArea
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief How the game ended, which decides how the mines are drawn
+     */
+    enum class Outcome { Playing, Won, Lost };
+
+    static constexpr int MinCellSize = 2;
+    static constexpr int MaxCellSize = 80;
+
+    explicit MineView(QWidget *parent = nullptr);
+
+    /**
+     * @brief Shows a new board; the field must outlive the view or be replaced
+     * @param field Board to draw
+     * @param cellSize Side of a cell in pixels
+     */
+    void setField(const MineField *field, int cellSize);
+
+    int cellSize() const { return side; }
+    void setCellSize(int size);
+
+    /**
+     * @brief Marks the end of a game; Lost shows every mine and the one hit
+     */
+    void setOutcome(Outcome outcome, int explodedCell = -1);
+    Outcome gameOutcome() const { return outcome; }
+
+    /**
+     * @brief Highlights one cell (the hint), -1 to clear
+     */
+    void setHighlight(int cell);
+
+    /**
+     * @brief Scrolls a cell to the middle of the view if it is not on screen
+     */
+    void scrollToCell(int cell);
+
+    /**
+     * @brief Repaints the given cells, or everything for a large batch
+     */
+    void updateCells(const std::vector<int> &cells);
+    void updateCell(int cell);
+
+signals:
+    void cellClicked(int cell);         ///< Left click on a cell
+    void cellRightClicked(int cell);    ///< Right click on a cell
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    bool viewportEvent(QEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void scrollContentsBy(int dx, int dy) override;
+
+private:
+    const MineField *field;
+    int side;                // cell size in pixels
+    int gap;                 // space between cells, 0 when zoomed far out
+    Outcome outcome;
+    int exploded;
+    int highlighted;
+    int hovered;
+    QFont numberFont;
+    QImage overview;         // reused for zoomed-out frames, sized to the viewport
+
+    QPoint origin() const;   // viewport position of cell (0, 0)
+    QRect cellRect(int cell) const;
+    int cellAt(const QPoint &pos) const;
+    void updateScrollBars();
+    void setHovered(int cell);
+    void paintCells(QPainter &painter, int firstRow, int lastRow, int firstCol, int lastCol);
+    void paintOverview(QPainter &painter, int firstRow, int lastRow, int firstCol, int lastCol);
+};
+
+#endif // MINEVIEW_H
@@ -0,0 +1,255 @@
+#include "sudokubatch.h"
+#include "sudokuengine.h"
+#include "sudokugenerator.h"
+#include "sudokulibrary.h"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QThread>
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Result {
+    SudokuEngine::Grid grid;
+    qint64 ns;
+    bool solved;
+};
+
+// Range of puzzle indices owned by one worker. The owner takes chunks from
+// the front, thieves take half of what is left from the back.
+struct WorkQueue {
+    std::mutex lock;
+    int begin = 0;
+    int end = 0;
+};
+
+// Small enough that a stolen range is rarely all hard puzzles, large enough
+// that the owner seldom touches its lock
+const int ChunkSize = 8;
+
+bool takeChunk(WorkQueue &queue, int &first, int &last)
+{
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (queue.begin >= queue.end) return false;
+    first = queue.begin;
+    last = std::min(queue.end, queue.begin + ChunkSize);
+    queue.begin = last;
+    return true;
+}
+
+// Moves half of some other worker's remaining range into our own queue
+bool steal(std::vector<WorkQueue> &queues, int self)
+{
+    int count = static_cast<int>(queues.size());
+    for (int k = 1; k < count; ++k) {
+        WorkQueue &victim = queues[(self + k) % count];
+        int first, last;
+        {
+            std::lock_guard<std::mutex> guard(victim.lock);
+            int remaining = victim.end - victim.begin;
+            if (remaining <= 0) continue;
+            last = victim.end;
+            first = last - (remaining + 1) / 2;
+            victim.end = first;
+        }
+        std::lock_guard<std::mutex> guard(queues[self].lock);
+        queues[self].begin = first;
+        queues[self].end = last;
+        return true;
+    }
+    return false;
+}
+
+// Calls job(i) for every index in the worker's queue, stealing when it runs dry
+template <typename Job>
+void work(std::vector<WorkQueue> &queues, int self, Job job)
+{
+    int first, last;
+    for (;;) {
+        if (!takeChunk(queues[self], first, last)) {
+            // Ranges only move between queues, so once every queue looks
+            // empty the rest is already in some worker's hands
+            if (!steal(queues, self)) return;
+            continue;
+        }
+        for (int i = first; i < last; ++i)
+            job(i);
+    }
+}
+
+// Even split of count indices up front, then one worker per queue;
+// makeJob(t) gives worker t its job, so each can keep its own engine
+template <typename MakeJob>
+void runWorkers(int count, int threads, MakeJob makeJob)
+{
+    // Stealing evens out whatever the split got wrong
+    std::vector<WorkQueue> queues(threads);
+    for (int t = 0; t < threads; ++t) {
+        queues[t].begin = static_cast<int>(static_cast<int64_t>(count) * t / threads);
+        queues[t].end = static_cast<int>(static_cast<int64_t>(count) * (t + 1) / threads);
+    }
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; ++t)
+        workers.emplace_back([&queues, t, &makeJob]() { work(queues, t, makeJob(t)); });
+    work(queues, 0, makeJob(0));
+    for (std::thread &worker : workers)
+        worker.join();
+}
+
+// Seeds are a fixed function of the index, so the same count always
+// builds the same library
+int makeLibrary(const QString &fileName, int perDifficulty, int threads, QTextStream &err)
+{
+    int count = perDifficulty * SudokuLibrary::DifficultyCount;
+    std::vector<SudokuEngine::Grid> generated(count);
+    QElapsedTimer wall;
+    wall.start();
+    runWorkers(count, std::max(1, std::min(threads, std::max(count, 1))), [&](int) {
+        return [&](int i) {
+            uint64_t seed = (uint64_t(i) + 1) * 0x9E3779B97F4A7C15ull;
+            auto difficulty = static_cast<SudokuGenerator::Difficulty>(i / perDifficulty);
+            generated[i] = SudokuGenerator::generate(seed, difficulty).givens;
+        };
+    });
+
+    std::vector<SudokuEngine::Grid> puzzles[SudokuLibrary::DifficultyCount];
+    for (int d = 0; d < SudokuLibrary::DifficultyCount; ++d)
+        puzzles[d].assign(generated.begin() + d * perDifficulty, generated.begin() + (d + 1) * perDifficulty);
+    if (!SudokuLibrary::write(fileName, puzzles)) {
+        err << "Cannot write " << fileName << "\n";
+        return 1;
+    }
+    err << "Wrote " << count << " puzzles to " << fileName << " in "
+        << QString::number(wall.nsecsElapsed() / 1e9, 'f', 1) << " s\n";
+    return 0;
+}
+
+// Digits with 0 or '.' for empty cells; anything after 81 cells is ignored
+bool parsePuzzle(const QByteArray &line, SudokuEngine::Grid &grid)
+{
+    int cell = 0;
+    for (char ch : line) {
+        if (cell == SudokuEngine::CellCount) break;
+        if (ch == ' ' || ch == '\t') continue;
+        if (ch == '.' || ch == '0') grid[cell++] = 0;
+        else if (ch >= '1' && ch <= '9') grid[cell++] = ch - '0';
+        else return false;
+    }
+    return cell == SudokuEngine::CellCount;
+}
+
+} // namespace
+
+bool SudokuBatch::requested(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--batch") == 0 || std::strncmp(argv[i], "--batch=", 8) == 0)
+            return true;
+        if (std::strcmp(argv[i], "--make-library") == 0 || std::strncmp(argv[i], "--make-library=", 15) == 0)
+            return true;
+    }
+    return false;
+}
+
+int SudokuBatch::run(QCoreApplication &app)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Solves a file of 81-character Sudoku puzzles, or builds a puzzle "
+                                     "library, without the UI.");
+    parser.addHelpOption();
+    QCommandLineOption batchOption("batch", "Puzzle file, one puzzle per line ('-' for stdin).", "file");
+    QCommandLineOption outputOption({"o", "output"}, "Where to write solutions and timings (default stdout).", "file", "-");
+    QCommandLineOption threadsOption({"j", "threads"}, "Worker threads (default one per core).", "N");
+    QCommandLineOption libraryOption("make-library", "Generate a puzzle library file instead of solving.", "file");
+    QCommandLineOption countOption({"n", "count"}, "Puzzles per difficulty in the library (default 1000).", "N", "1000");
+    parser.addOptions({batchOption, outputOption, threadsOption, libraryOption, countOption});
+    parser.process(app);
+
+    QTextStream err(stderr);
+    int threads = parser.isSet(threadsOption) ? parser.value(threadsOption).toInt()
+                                              : QThread::idealThreadCount();
+    if (parser.isSet(libraryOption))
+        return makeLibrary(parser.value(libraryOption), qMax(1, parser.value(countOption).toInt()), threads, err);
+
+    QFile input;
+    QString inputName = parser.value(batchOption);
+    bool opened = inputName == "-" ? input.open(stdin, QIODevice::ReadOnly)
+                                   : (input.setFileName(inputName), input.open(QIODevice::ReadOnly));
+    if (!opened) {
+        err << "Cannot open " << inputName << "\n";
+        return 1;
+    }
+
+    std::vector<SudokuEngine::Grid> puzzles;
+    int lineNumber = 0;
+    for (;;) {
+        // readLine() keeps the newline, so only the end of input is empty
+        QByteArray line = input.readLine();
+        if (line.isEmpty()) break;
+        line = line.trimmed();
+        ++lineNumber;
+        if (line.isEmpty() || line.startsWith('#')) continue;
+        SudokuEngine::Grid grid;
+        if (parsePuzzle(line, grid))
+            puzzles.push_back(grid);
+        else
+            err << inputName << ":" << lineNumber << ": not a puzzle, skipped\n";
+    }
+
+    int count = static_cast<int>(puzzles.size());
+    threads = std::max(1, std::min(threads, std::max(count, 1)));
+
+    std::vector<Result> results(puzzles.size());
+    std::vector<SudokuEngine> engines(threads);
+    QElapsedTimer wall;
+    wall.start();
+    runWorkers(count, threads, [&](int t) {
+        return [&puzzles, &results, &engine = engines[t]](int i) {
+            QElapsedTimer clock;
+            clock.start();
+            engine.load(puzzles[i]);
+            bool solved = engine.solve() == SudokuEngine::Status::Solved;
+            results[i] = {engine.grid(), clock.nsecsElapsed(), solved};
+        };
+    });
+    qint64 elapsed = wall.nsecsElapsed();
+
+    QFile output;
+    QString outputName = parser.value(outputOption);
+    opened = outputName == "-" ? output.open(stdout, QIODevice::WriteOnly)
+                               : (output.setFileName(outputName), output.open(QIODevice::WriteOnly));
+    if (!opened) {
+        err << "Cannot write " << outputName << "\n";
+        return 1;
+    }
+
+    // One line per puzzle: solution (or "unsolvable") and solve time in microseconds
+    int solved = 0;
+    QByteArray text;
+    text.reserve(static_cast<qsizetype>(results.size()) * 96);
+    for (const Result &result : results) {
+        if (result.solved) {
+            ++solved;
+            for (uint8_t value : result.grid)
+                text.append(char('0' + value));
+        } else {
+            text.append("unsolvable");
+        }
+        text.append('\t');
+        text.append(QByteArray::number(result.ns / 1000.0, 'f', 1));
+        text.append('\n');
+    }
+    output.write(text);
+
+    double seconds = elapsed / 1e9;
+    err << "Solved " << solved << "/" << count << " puzzles on " << threads << " threads in "
+        << QString::number(seconds * 1000.0, 'f', 1) << " ms ("
+        << QString::number(seconds > 0 ? count / seconds : 0.0, 'f', 0) << " puzzles/s)\n";
+    return solved == count ? 0 : 2;
+}
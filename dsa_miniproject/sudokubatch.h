@@ -0,0 +1,24 @@
+#ifndef SUDOKUBATCH_H
+#define SUDOKUBATCH_H
+
+#include <QCoreApplication>
+
+// Headless solving of a whole puzzle file, started with --batch.
+// Puzzles are split across one worker per core; a worker that runs dry
+// steals half of the remaining range from a busy one, so a few slow
+// puzzles don't leave the other cores idle. Solutions and per-puzzle
+// timings are written in input order.
+// --make-library generates rated puzzles the same way and writes them as a
+// SudokuLibrary file instead.
+class SudokuBatch
+{
+public:
+    // True if the command line asks for a headless mode, checked before any
+    // application object exists so the GUI is never created
+    static bool requested(int argc, char *argv[]);
+
+    // Parses the options, does the work and returns the exit code
+    static int run(QCoreApplication &app);
+};
+
+#endif // SUDOKUBATCH_H
@@ -1,263 +1,422 @@
 #include "sudokuboard.h"
+#include "sudokumodel.h"
 #include <QKeyEvent>
-#include <QRegularExpressionValidator>
-#include <QFont>
-#include <QFrame>
-#include <QVBoxLayout>
-#include <QDebug>
+#include <QMouseEvent>
+#include <QPaintEvent>
+#include <QPainter>
+#include <QRegion>
+#include <algorithm>
 
 SudokuBoard::SudokuBoard(QWidget *parent) : QWidget(parent)
 {
-    // ... (same constructor as before)
-    QGridLayout *mainGrid = new QGridLayout(this);
-    mainGrid->setSpacing(0);
-    mainGrid->setContentsMargins(0, 0, 0, 0);
-
-    cells.resize(9, QVector<QLineEdit*>(9, nullptr));
-    readOnlyCells.resize(9, QVector<bool>(9, false));
-
-    QFrame *outerFrame = new QFrame(this);
-    outerFrame->setFrameStyle(QFrame::Box);
-    outerFrame->setLineWidth(3);
-    outerFrame->setStyleSheet("QFrame { border: 3px solid #2c3e50; }");
-    QGridLayout *outerLayout = new QGridLayout(outerFrame);
-    outerLayout->setSpacing(0);
-    outerLayout->setContentsMargins(0, 0, 0, 0);
-
-    for (int blockRow = 0; blockRow < 3; ++blockRow) {
-        for (int blockCol = 0; blockCol < 3; ++blockCol) {
-            QFrame *block = new QFrame(outerFrame);
-            block->setFrameStyle(QFrame::Box);
-            block->setLineWidth(2);
-            block->setStyleSheet("QFrame { border: 2px solid #4a4a4a; }");
-
-            QGridLayout *blockLayout = new QGridLayout(block);
-            blockLayout->setSpacing(0);
-            blockLayout->setContentsMargins(0, 0, 0, 0);
-
-            for (int i = 0; i < 3; ++i) {
-                for (int j = 0; j < 3; ++j) {
-                    int row = blockRow * 3 + i;
-                    int col = blockCol * 3 + j;
-
-                    QLineEdit *cell = new QLineEdit(block);
-                    cell->setAlignment(Qt::AlignCenter);
-                    cell->setMaxLength(1);
-                    cell->setFixedSize(64, 64);
-                    QFont font("Arial", 24, QFont::Bold);
-                    cell->setFont(font);
-                    cell->setValidator(new QRegularExpressionValidator(QRegularExpression("[1-9]"), cell));
-                    cell->installEventFilter(this);
-
-                    cell->setStyleSheet(
-                        "QLineEdit { border: 1px solid #d0d0d0; background-color: white; padding-bottom: 4px; }"
-                        "QLineEdit:focus { border: 2px solid #3498db; }"
-                        );
-
-                    blockLayout->addWidget(cell, i, j);
-                    cells[row][col] = cell;
-
-                    connect(cell, &QLineEdit::textEdited, this, [this, row, col](const QString &newText) {
-                        onCellTextEdited(newText, row, col);
-                    });
-                }
-            }
-            outerLayout->addWidget(block, blockRow, blockCol);
-        }
-    }
+    boardModel = nullptr;
+    box = 3;
+    readOnlyCells = QVector<bool>(81, false);
+    inputEnabled = true;
+    showNotes = false;
+    selected = -1;
+    setFocusPolicy(Qt::StrongFocus);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    updateGeometryCache();
+}
 
-    mainGrid->addWidget(outerFrame, 0, 0);
-    setStyleSheet("background-color: #f0f0f0;");
-}
-
-void SudokuBoard::setBoard(const QVector<QVector<int>> &initial, const QVector<QVector<int>> &)
-{
-    for (int row = 0; row < 9; ++row) {
-        for (int col = 0; col < 9; ++col) {
-            int val = initial[row][col];
-            QLineEdit *cell = cells[row][col];
-            if (val != 0) {
-                cell->setText(QString::number(val));
-                cell->setReadOnly(true);
-                readOnlyCells[row][col] = true;
-                cell->setStyleSheet(cell->styleSheet() + " QLineEdit { color: #1a1a1a; }");
-            } else {
-                cell->clear();
-                cell->setReadOnly(false);
-                readOnlyCells[row][col] = false;
-                cell->setStyleSheet(cell->styleSheet() + " QLineEdit { color: #333333; }");
-            }
-        }
-    }
-    undoStack.clear();
-    oldValueMap.clear();
-    checkAllConflicts();
+void SudokuBoard::setModel(SudokuModel *model)
+{
+    if (boardModel)
+        disconnect(boardModel, nullptr, this, nullptr);
+    boardModel = model;
+    history.setModel(model);
+    connect(boardModel, &SudokuModel::modelReset, this, &SudokuBoard::onModelReset);
+    connect(boardModel, &SudokuModel::cellChanged, this, &SudokuBoard::onCellChanged);
+    connect(boardModel, &SudokuModel::conflictChanged, this, &SudokuBoard::onConflictChanged);
+    connect(boardModel, &SudokuModel::cellsChanged, this, &SudokuBoard::onCellsChanged);
+    connect(boardModel, &SudokuModel::notesChanged, this, &SudokuBoard::onNotesChanged);
+    onModelReset();
+}
+
+QString SudokuBoard::symbolFor(int value)
+{
+    if (value <= 0) return QString();
+    if (value <= 9) return QString::number(value);
+    return QString(QChar('A' + value - 10));
+}
+
+int SudokuBoard::valueFor(const QString &symbol, int size)
+{
+    if (symbol.isEmpty()) return 0;
+    QChar ch = symbol.at(0).toUpper();
+    int value = 0;
+    if (ch >= '1' && ch <= '9') value = ch.unicode() - '0';
+    else if (ch >= 'A' && ch <= 'Z') value = ch.unicode() - 'A' + 10;
+    return value <= size ? value : 0;
+}
+
+void SudokuBoard::onModelReset()
+{
+    box = boardModel->boxSize();
+    readOnlyCells = QVector<bool>(boardModel->cellCount(), false);
+    for (int cell = 0; cell < boardModel->cellCount(); ++cell)
+        readOnlyCells[cell] = boardModel->isGiven(cell);
+    selected = -1;
+    history.clear();
+    highlights.assign(boardModel->cellCount(), NoHighlight);
+    highlighted.clear();
+    updateGeometryCache();
+    update();
+}
+
+void SudokuBoard::onCellChanged(int cell, int)
+{
+    clearHighlights();
+    update(cellRect(cell));
+}
+
+void SudokuBoard::onConflictChanged(int cell, bool)
+{
+    update(cellRect(cell));
+}
+
+void SudokuBoard::onCellsChanged(const std::vector<int> &cells)
+{
+    // One repaint request for the whole batch
+    clearHighlights();
+    QRegion region;
+    for (int cell : cells)
+        region += cellRect(cell);
+    update(region);
+}
+
+void SudokuBoard::onNotesChanged(const std::vector<int> &cells)
+{
+    if (!showNotes) return;
+    QRegion region;
+    for (int cell : cells)
+        region += cellRect(cell);
+    update(region);
 }
 
 void SudokuBoard::clearUserEntries()
 {
-    for (int row = 0; row < 9; ++row) {
-        for (int col = 0; col < 9; ++col) {
-            if (!readOnlyCells[row][col]) {
-                cells[row][col]->clear();
-            }
-        }
-    }
-    checkAllConflicts();
+    history.clearEntries();
 }
 
 void SudokuBoard::undo()
 {
-    if (!undoStack.isEmpty()) {
-        UndoEntry entry = undoStack.last();
-        cells[entry.row][entry.col]->setText(entry.oldValue);
-        undoStack.pop_back();
-        checkAllConflicts();
-    }
+    history.undo();
+}
+
+void SudokuBoard::redo()
+{
+    history.redo();
+}
+
+bool SudokuBoard::applyMove(const std::vector<SudokuChange> &changes)
+{
+    return history.setValues(changes);
+}
+
+bool SudokuBoard::restoreHistory(const std::vector<uint16_t> &ops, size_t position)
+{
+    return history.restore(ops, position);
 }
 
 void SudokuBoard::setCellReadOnly(int row, int col, bool readOnly)
 {
-    cells[row][col]->setReadOnly(readOnly);
-    readOnlyCells[row][col] = readOnly;
+    readOnlyCells[row * size() + col] = readOnly;
 }
 
 bool SudokuBoard::isCellReadOnly(int row, int col) const
 {
-    return readOnlyCells[row][col];
+    return readOnlyCells[row * size() + col];
 }
 
 int SudokuBoard::getValue(int row, int col) const
 {
-    QString text = cells[row][col]->text();
-    return text.isEmpty() ? 0 : text.toInt();
+    return boardModel->value(row, col);
 }
 
 void SudokuBoard::setValue(int row, int col, int value, bool recordUndo)
 {
-    QLineEdit *cell = cells[row][col];
-    if (recordUndo && !readOnlyCells[row][col]) {
-        // Store old value for undo
-        QString oldText = cell->text();
-        if (oldText != (value >= 1 && value <= 9 ? QString::number(value) : "")) {
-            UndoEntry entry;
-            entry.row = row;
-            entry.col = col;
-            entry.oldValue = oldText;
-            undoStack.push_back(entry);
-        }
-    }
-    if (value >= 1 && value <= 9)
-        cell->setText(QString::number(value));
+    int cell = boardModel->index(row, col);
+    if (recordUndo && !readOnlyCells[cell])
+        history.setValue(cell, value);
     else
-        cell->clear();
-    checkAllConflicts();
+        boardModel->setValue(cell, value);
 }
 
 void SudokuBoard::setAllReadOnly(const QVector<QVector<bool>> &readOnlyMap)
 {
-    for (int row = 0; row < 9; ++row)
-        for (int col = 0; col < 9; ++col)
+    for (int row = 0; row < size(); ++row)
+        for (int col = 0; col < size(); ++col)
             setCellReadOnly(row, col, readOnlyMap[row][col]);
 }
 
 void SudokuBoard::setAllCellsEnabled(bool enabled)
 {
-    for (int row = 0; row < 9; ++row)
-        for (int col = 0; col < 9; ++col)
-            cells[row][col]->setEnabled(enabled);
+    inputEnabled = enabled;
+    if (!enabled) select(-1);
+    update();
 }
 
-void SudokuBoard::checkAllConflicts()
+void SudokuBoard::setNotesMode(bool enabled)
 {
-    for (int row = 0; row < 9; ++row) {
-        for (int col = 0; col < 9; ++col) {
-            updateConflictsForCell(row, col);
-        }
-    }
+    if (showNotes == enabled) return;
+    showNotes = enabled;
+    update();
+}
+
+void SudokuBoard::toggleNote(int row, int col, int value)
+{
+    boardModel->toggleNote(boardModel->index(row, col), value);
 }
 
-void SudokuBoard::onCellTextEdited(const QString &newText, int row, int col)
+void SudokuBoard::setHighlights(const std::vector<int> &pattern, const std::vector<int> &targets)
 {
-    QLineEdit *cell = cells[row][col];
-    QString oldText = oldValueMap.value(cell, QString());
-    if (oldText != newText) {
-        UndoEntry entry;
-        entry.row = row;
-        entry.col = col;
-        entry.oldValue = oldText;
-        undoStack.push_back(entry);
+    clearHighlights();
+    for (int cell : pattern)
+        highlights[cell] = PatternHighlight;
+    for (int cell : targets)
+        highlights[cell] = TargetHighlight;
+    QRegion region;
+    for (int cell = 0; cell < static_cast<int>(highlights.size()); ++cell) {
+        if (highlights[cell] == NoHighlight) continue;
+        highlighted.push_back(cell);
+        region += cellRect(cell);
     }
-    checkAllConflicts();
+    update(region);
 }
 
-void SudokuBoard::applyConflictStyle(int row, int col, bool hasConflict)
+void SudokuBoard::clearHighlights()
 {
-    QLineEdit *cell = cells[row][col];
-    QString currentStyle = cell->styleSheet();
-    currentStyle.remove("border-bottom: 2px solid red;");
-    if (hasConflict) {
-        currentStyle += " QLineEdit { border-bottom: 2px solid red; }";
+    if (highlighted.empty()) return;
+    QRegion region;
+    for (int cell : highlighted) {
+        highlights[cell] = NoHighlight;
+        region += cellRect(cell);
     }
-    cell->setStyleSheet(currentStyle);
+    highlighted.clear();
+    update(region);
 }
 
-bool SudokuBoard::hasConflict(int row, int col) const
+void SudokuBoard::updateGeometryCache()
 {
-    int value = getValue(row, col);
-    if (value == 0) return false;
+    // Square grid centred in the widget, 3px outer frame included
+    int side = qMin(width(), height());
+    gridRect = QRect((width() - side) / 2, (height() - side) / 2, side, side).adjusted(3, 3, -3, -3);
+    digitFont = QFont("Arial");
+    digitFont.setBold(true);
+    digitFont.setPixelSize(qMax(8, gridRect.width() / size() / 2));
+    noteFont = QFont("Arial");
+    noteFont.setPixelSize(qMax(5, gridRect.width() / size() / box * 3 / 4));
+}
 
-    for (int c = 0; c < 9; ++c) {
-        if (c != col && getValue(row, c) == value) return true;
-    }
-    for (int r = 0; r < 9; ++r) {
-        if (r != row && getValue(r, col) == value) return true;
-    }
-    int startRow = (row / 3) * 3;
-    int startCol = (col / 3) * 3;
-    for (int r = startRow; r < startRow + 3; ++r) {
-        for (int c = startCol; c < startCol + 3; ++c) {
-            if ((r != row || c != col) && getValue(r, c) == value) return true;
-        }
-    }
-    return false;
+QRect SudokuBoard::cellRect(int cell) const
+{
+    int n = size();
+    int row = cell / n, col = cell % n;
+    int x0 = gridRect.left() + col * gridRect.width() / n;
+    int x1 = gridRect.left() + (col + 1) * gridRect.width() / n;
+    int y0 = gridRect.top() + row * gridRect.height() / n;
+    int y1 = gridRect.top() + (row + 1) * gridRect.height() / n;
+    return QRect(x0, y0, x1 - x0, y1 - y0);
 }
 
-void SudokuBoard::updateConflictsForCell(int row, int col)
+int SudokuBoard::cellAt(const QPoint &pos) const
 {
-    bool conflict = hasConflict(row, col);
-    applyConflictStyle(row, col, conflict);
+    if (!gridRect.contains(pos)) return -1;
+    int n = size();
+    int col = (pos.x() - gridRect.left()) * n / gridRect.width();
+    int row = (pos.y() - gridRect.top()) * n / gridRect.height();
+    return qBound(0, row, n - 1) * n + qBound(0, col, n - 1);
 }
 
-void SudokuBoard::storeOldValueForCell(QLineEdit *cell, int row, int col)
+void SudokuBoard::select(int cell)
 {
-    Q_UNUSED(row);
-    Q_UNUSED(col);
-    oldValueMap[cell] = cell->text();
+    if (cell == selected) return;
+    if (selected >= 0) update(cellRect(selected));
+    selected = cell;
+    if (selected < 0) return;
+    update(cellRect(selected));
+    emit cellFocused(selected / size(), selected % size());
 }
 
-bool SudokuBoard::eventFilter(QObject *obj, QEvent *event)
+void SudokuBoard::paintEvent(QPaintEvent *event)
 {
-    if (event->type() == QEvent::FocusIn) {
-        QLineEdit *cell = qobject_cast<QLineEdit*>(obj);
-        if (cell) {
-            for (int r = 0; r < 9; ++r) {
-                for (int c = 0; c < 9; ++c) {
-                    if (cells[r][c] == cell) {
-                        storeOldValueForCell(cell, r, c);
-                        emit cellFocused(r, c);   // <-- new signal emission
-                        break;
-                    }
+    QPainter painter(this);
+    painter.fillRect(event->rect(), QColor("#f0f0f0"));
+    if (!boardModel) return;
+
+    int n = size();
+    painter.setFont(digitFont);
+
+    // Only the cells inside the dirty region
+    QRect dirty = event->rect().intersected(gridRect);
+    int firstCol = 0, lastCol = -1, firstRow = 0, lastRow = -1;
+    if (!dirty.isEmpty()) {
+        firstCol = (dirty.left() - gridRect.left()) * n / gridRect.width();
+        lastCol = qMin(n - 1, (dirty.right() - gridRect.left()) * n / gridRect.width());
+        firstRow = (dirty.top() - gridRect.top()) * n / gridRect.height();
+        lastRow = qMin(n - 1, (dirty.bottom() - gridRect.top()) * n / gridRect.height());
+    }
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int col = firstCol; col <= lastCol; ++col) {
+            int cell = row * n + col;
+            QRect rect = cellRect(cell);
+            QColor background = Qt::white;
+            if (highlights[cell] == PatternHighlight) background = QColor("#fcf3cf");
+            else if (highlights[cell] == TargetHighlight) background = QColor("#d5f5e3");
+            if (cell == selected) background = QColor("#d6eaf8");
+            painter.fillRect(rect, background);
+            painter.setPen(QColor("#d0d0d0"));
+            painter.drawRect(rect.adjusted(0, 0, -1, -1));
+
+            int value = boardModel->value(cell);
+            if (value) {
+                QColor color = readOnlyCells[cell] ? QColor("#1a1a1a") : QColor("#333333");
+                if (!inputEnabled && !readOnlyCells[cell]) color = QColor("#7f8c8d");
+                painter.setPen(color);
+                painter.drawText(rect, Qt::AlignCenter, symbolFor(value));
+            } else if (showNotes && boardModel->notes(cell)) {
+                // Digit d sits at slot d - 1 of a box-shaped mini-grid
+                uint32_t notes = boardModel->notes(cell);
+                painter.setFont(noteFont);
+                painter.setPen(QColor("#7f8c8d"));
+                for (int digit = 1; digit <= n; ++digit) {
+                    if (!(notes & (1u << (digit - 1)))) continue;
+                    int slotRow = (digit - 1) / box, slotCol = (digit - 1) % box;
+                    QRect slot(rect.left() + slotCol * rect.width() / box, rect.top() + slotRow * rect.height() / box,
+                               rect.width() / box, rect.height() / box);
+                    painter.drawText(slot, Qt::AlignCenter, symbolFor(digit));
                 }
+                painter.setFont(digitFont);
             }
+            if (boardModel->hasConflict(cell))
+                painter.fillRect(rect.left() + 1, rect.bottom() - 2, rect.width() - 2, 2, Qt::red);
         }
     }
-    else if (event->type() == QEvent::KeyPress) {
-        QKeyEvent *keyEvent = static_cast<QKeyEvent*>(event);
-        if (keyEvent->key() == Qt::Key_Backspace) {
-            undo();
-            return true;
+
+    // Box lines and the outer frame on top of the cells
+    const SudokuUnits &rules = boardModel->constraints();
+    painter.setPen(QPen(QColor("#4a4a4a"), 2));
+    if (rules.isClassic()) {
+        for (int k = box; k < n; k += box) {
+            int x = gridRect.left() + k * gridRect.width() / n;
+            int y = gridRect.top() + k * gridRect.height() / n;
+            painter.drawLine(x, gridRect.top(), x, gridRect.bottom());
+            painter.drawLine(gridRect.left(), y, gridRect.right(), y);
         }
+    } else {
+        paintVariant(painter, rules);
+    }
+    painter.setPen(QPen(QColor("#2c3e50"), 3));
+    painter.drawRect(gridRect.adjusted(-1, -1, 1, 1));
+
+    if (selected >= 0) {
+        painter.setPen(QPen(QColor("#3498db"), 2));
+        painter.drawRect(cellRect(selected).adjusted(1, 1, -1, -1));
+    }
+}
+
+void SudokuBoard::paintVariant(QPainter &painter, const SudokuUnits &rules)
+{
+    int n = size();
+
+    // Region borders run wherever two neighbours sit in different regions,
+    // which is the box grid unless the regions are jigsaw pieces
+    for (int cell = 0; cell < n * n; ++cell) {
+        QRect rect = cellRect(cell);
+        int row = cell / n, col = cell % n;
+        if (col + 1 < n && rules.regionOf(cell) != rules.regionOf(cell + 1))
+            painter.drawLine(rect.right() + 1, rect.top(), rect.right() + 1, rect.bottom() + 1);
+        if (row + 1 < n && rules.regionOf(cell) != rules.regionOf(cell + n))
+            painter.drawLine(rect.left(), rect.bottom() + 1, rect.right() + 1, rect.bottom() + 1);
+    }
+
+    if (rules.hasDiagonals()) {
+        painter.setPen(QPen(QColor("#aab7b8"), 1, Qt::DashLine));
+        painter.drawLine(gridRect.topLeft(), gridRect.bottomRight());
+        painter.drawLine(gridRect.topRight(), gridRect.bottomLeft());
+    }
+
+    // Cages: a dotted outline just inside their cells, sum in the first one
+    painter.setPen(QPen(QColor("#566573"), 1, Qt::DotLine));
+    for (int cell = 0; cell < n * n; ++cell) {
+        int cage = rules.cageOf(cell);
+        if (cage < 0) continue;
+        QRect inner = cellRect(cell).adjusted(3, 3, -3, -3);
+        int row = cell / n, col = cell % n;
+        if (row == 0 || rules.cageOf(cell - n) != cage) painter.drawLine(inner.topLeft(), inner.topRight());
+        if (row == n - 1 || rules.cageOf(cell + n) != cage) painter.drawLine(inner.bottomLeft(), inner.bottomRight());
+        if (col == 0 || rules.cageOf(cell - 1) != cage) painter.drawLine(inner.topLeft(), inner.bottomLeft());
+        if (col == n - 1 || rules.cageOf(cell + 1) != cage) painter.drawLine(inner.topRight(), inner.bottomRight());
+    }
+    painter.setFont(noteFont);
+    painter.setPen(QColor("#2c3e50"));
+    for (int unit = 0; unit < rules.unitCount(); ++unit) {
+        if (rules.kind(unit) != SudokuUnits::Kind::Cage) continue;
+        int first = *std::min_element(rules.cells(unit).begin(), rules.cells(unit).end());
+        QRect corner = cellRect(first).adjusted(4, 2, 0, 0);
+        painter.drawText(corner, Qt::AlignLeft | Qt::AlignTop, QString::number(rules.sum(unit)));
+    }
+    painter.setFont(digitFont);
+}
+
+void SudokuBoard::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    updateGeometryCache();
+}
+
+void SudokuBoard::mousePressEvent(QMouseEvent *event)
+{
+    if (!inputEnabled) return;
+    int cell = cellAt(event->pos());
+    if (cell >= 0) {
+        setFocus();
+        select(cell);
+    }
+}
+
+void SudokuBoard::keyPressEvent(QKeyEvent *event)
+{
+    if (!inputEnabled || !boardModel) {
+        QWidget::keyPressEvent(event);
+        return;
+    }
+
+    if (event->matches(QKeySequence::Undo)) {
+        undo();
+        return;
+    }
+    if (event->matches(QKeySequence::Redo)) {
+        redo();
+        return;
+    }
+
+    int n = size();
+    int row = selected >= 0 ? selected / n : 0;
+    int col = selected >= 0 ? selected % n : 0;
+    switch (event->key()) {
+    case Qt::Key_Left: select(row * n + (col + n - 1) % n); return;
+    case Qt::Key_Right: select(row * n + (col + 1) % n); return;
+    case Qt::Key_Up: select((row + n - 1) % n * n + col); return;
+    case Qt::Key_Down: select((row + 1) % n * n + col); return;
+    case Qt::Key_Backspace: undo(); return;
+    case Qt::Key_Delete:
+    case Qt::Key_0:
+        if (selected >= 0 && !readOnlyCells[selected])
+            setValue(row, col, 0, true);
+        return;
+    }
+
+    int value = valueFor(event->text(), n);
+    if (selected >= 0 && value > 0) {
+        if (showNotes)
+            toggleNote(row, col, value);
+        else if (!readOnlyCells[selected])
+            setValue(row, col, value, true);
+        return;
     }
-    return QWidget::eventFilter(obj, event);
+    QWidget::keyPressEvent(event);
 }
@@ -2,48 +2,93 @@
 #define SUDOKUBOARD_H
 
 #include <QWidget>
-#include <QGridLayout>
-#include <QLineEdit>
 #include <QVector>
-#include <QMap>
+#include <QFont>
+#include <cstdint>
+#include <vector>
+#include "sudokuhistory.h"
 
+class QPainter;
+class SudokuModel;
+class SudokuUnits;
+
+// View of a SudokuModel, painted directly: no child widgets and no style
+// sheets. Model changes repaint only the cells they touch; mouse clicks
+// select a cell and the keyboard enters, clears and moves the selection.
 class SudokuBoard : public QWidget
 {
     Q_OBJECT
 
 public:
     explicit SudokuBoard(QWidget *parent = nullptr);
-    void setBoard(const QVector<QVector<int>> &initial, const QVector<QVector<int>> &solution);
-    void clearUserEntries();
+    void setModel(SudokuModel *model);
+    SudokuModel *model() const { return boardModel; }
+    int boxSize() const { return box; }
+    int size() const { return box * box; }
+    static QString symbolFor(int value);   // 1-9, then A, B, ... for 10 and up
+    static int valueFor(const QString &symbol, int size);   // 0 unless a symbol of a size x size board
+    void clearUserEntries();   // one undoable move
     void undo();
+    void redo();
+    bool applyMove(const std::vector<SudokuChange> &changes);   // several cells, one undo step
+    const SudokuHistory &undoHistory() const { return history; }
+    bool restoreHistory(const std::vector<uint16_t> &ops, size_t position);
     void setCellReadOnly(int row, int col, bool readOnly);
     bool isCellReadOnly(int row, int col) const;
     int getValue(int row, int col) const;
     void setValue(int row, int col, int value, bool recordUndo = false);  // added recordUndo
     void setAllReadOnly(const QVector<QVector<bool>> &readOnlyMap);
     void setAllCellsEnabled(bool enabled);
-    void checkAllConflicts();
+
+    // Notes mode shows each empty cell's candidate notes as a Box x Box
+    // mini-grid, and digits typed there toggle notes instead of placing
+    void setNotesMode(bool enabled);
+    bool notesMode() const { return showNotes; }
+    void toggleNote(int row, int col, int value);
+
+    // Hint colouring: pattern cells justify a step, target cells are the
+    // ones it fills or trims. Any change to the board clears it.
+    void setHighlights(const std::vector<int> &pattern, const std::vector<int> &targets);
+    void clearHighlights();
 
 signals:
     void cellFocused(int row, int col);
 
 protected:
-    bool eventFilter(QObject *obj, QEvent *event) override;
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void keyPressEvent(QKeyEvent *event) override;
 
 private slots:
-    void onCellTextEdited(const QString &newText, int row, int col);
+    void onModelReset();
+    void onCellChanged(int cell, int value);
+    void onConflictChanged(int cell, bool conflict);
+    void onCellsChanged(const std::vector<int> &cells);
+    void onNotesChanged(const std::vector<int> &cells);
 
 private:
-    QVector<QVector<QLineEdit*>> cells;
-    QVector<QVector<bool>> readOnlyCells;
-    QMap<QLineEdit*, QString> oldValueMap;
-    struct UndoEntry { int row, col; QString oldValue; };
-    QVector<UndoEntry> undoStack;
-
-    void applyConflictStyle(int row, int col, bool hasConflict);
-    bool hasConflict(int row, int col) const;
-    void updateConflictsForCell(int row, int col);
-    void storeOldValueForCell(QLineEdit *cell, int row, int col);
+    SudokuModel *boardModel;
+    int box;
+    QVector<bool> readOnlyCells;   // row-major
+    bool inputEnabled;
+    bool showNotes;
+    int selected;                  // cell index, -1 for none
+    SudokuHistory history;
+    enum Highlight : uint8_t { NoHighlight, PatternHighlight, TargetHighlight };
+    std::vector<uint8_t> highlights;   // Highlight per cell
+    std::vector<int> highlighted;      // cells currently coloured
+
+    // Geometry, recomputed on resize
+    QRect gridRect;
+    QFont digitFont;
+    QFont noteFont;
+
+    QRect cellRect(int cell) const;
+    int cellAt(const QPoint &pos) const;
+    void select(int cell);
+    void updateGeometryCache();
+    void paintVariant(QPainter &painter, const SudokuUnits &rules);   // regions, diagonals and cages
 };
 
 #endif // SUDOKUBOARD_H
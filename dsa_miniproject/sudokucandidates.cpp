@@ -0,0 +1,131 @@
+#include "sudokucandidates.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SUDOKU_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace {
+
+template <int Box>
+void computeScalar(const SudokuCandidates::Mask<Box> *rowUsed, const SudokuCandidates::Mask<Box> *colUsed,
+                   const SudokuCandidates::Mask<Box> *boxUsed, SudokuCandidates::Mask<Box> *out)
+{
+    using Mask = SudokuCandidates::Mask<Box>;
+    constexpr int Size = Box * Box;
+    constexpr Mask All = static_cast<Mask>((uint64_t(1) << Size) - 1);
+    for (int r = 0; r < Size; ++r) {
+        const Mask *boxes = boxUsed + r / Box * Box;
+        for (int c = 0; c < Size; ++c)
+            out[r * Size + c] = All & ~(rowUsed[r] | colUsed[c] | boxes[c / Box]);
+    }
+}
+
+#ifdef SUDOKU_X86_KERNELS
+
+// Both vector kernels work on 16 lanes per row: the column masks are loaded
+// once, the box masks once per band, and each row only adds its own mask.
+// Rows are stored back to back, so on 9x9 the spare lanes of one row land
+// on the next row's cells (rewritten right after) or in the padding.
+
+template <int Box>
+__attribute__((target("sse2")))
+void computeSse2(const uint16_t *rowUsed, const uint16_t *colUsed, const uint16_t *boxUsed, uint16_t *out)
+{
+    constexpr int Size = Box * Box;
+    alignas(16) uint16_t cols[16] = {};
+    alignas(16) uint16_t boxes[16] = {};
+    for (int c = 0; c < Size; ++c)
+        cols[c] = colUsed[c];
+
+    const __m128i all = _mm_set1_epi16(static_cast<short>((1u << Size) - 1));
+    const __m128i colLo = _mm_load_si128(reinterpret_cast<const __m128i *>(cols));
+    const __m128i colHi = _mm_load_si128(reinterpret_cast<const __m128i *>(cols + 8));
+    for (int band = 0; band < Box; ++band) {
+        for (int c = 0; c < Size; ++c)
+            boxes[c] = boxUsed[band * Box + c / Box];
+        __m128i lo = _mm_or_si128(colLo, _mm_load_si128(reinterpret_cast<const __m128i *>(boxes)));
+        __m128i hi = _mm_or_si128(colHi, _mm_load_si128(reinterpret_cast<const __m128i *>(boxes + 8)));
+        for (int i = 0; i < Box; ++i) {
+            int r = band * Box + i;
+            __m128i row = _mm_set1_epi16(static_cast<short>(rowUsed[r]));
+            __m128i *dst = reinterpret_cast<__m128i *>(out + r * Size);
+            _mm_storeu_si128(dst, _mm_andnot_si128(_mm_or_si128(lo, row), all));
+            _mm_storeu_si128(dst + 1, _mm_andnot_si128(_mm_or_si128(hi, row), all));
+        }
+    }
+}
+
+template <int Box>
+__attribute__((target("avx2")))
+void computeAvx2(const uint16_t *rowUsed, const uint16_t *colUsed, const uint16_t *boxUsed, uint16_t *out)
+{
+    constexpr int Size = Box * Box;
+    alignas(32) uint16_t cols[16] = {};
+    alignas(32) uint16_t boxes[16] = {};
+    for (int c = 0; c < Size; ++c)
+        cols[c] = colUsed[c];
+
+    const __m256i all = _mm256_set1_epi16(static_cast<short>((1u << Size) - 1));
+    const __m256i col = _mm256_load_si256(reinterpret_cast<const __m256i *>(cols));
+    for (int band = 0; band < Box; ++band) {
+        for (int c = 0; c < Size; ++c)
+            boxes[c] = boxUsed[band * Box + c / Box];
+        __m256i fixed = _mm256_or_si256(col, _mm256_load_si256(reinterpret_cast<const __m256i *>(boxes)));
+        for (int i = 0; i < Box; ++i) {
+            int r = band * Box + i;
+            __m256i row = _mm256_set1_epi16(static_cast<short>(rowUsed[r]));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + r * Size),
+                                _mm256_andnot_si256(_mm256_or_si256(fixed, row), all));
+        }
+    }
+}
+
+#endif // SUDOKU_X86_KERNELS
+
+SudokuCandidates::Kernel detectKernel()
+{
+#ifdef SUDOKU_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SudokuCandidates::Kernel::AVX2;
+    if (__builtin_cpu_supports("sse2")) return SudokuCandidates::Kernel::SSE2;
+#endif
+    return SudokuCandidates::Kernel::Scalar;
+}
+
+} // namespace
+
+SudokuCandidates::Kernel SudokuCandidates::kernel()
+{
+    static const Kernel active = detectKernel();
+    return active;
+}
+
+const char *SudokuCandidates::kernelName(Kernel kernel)
+{
+    switch (kernel) {
+    case Kernel::Scalar: return "scalar";
+    case Kernel::SSE2: return "sse2";
+    case Kernel::AVX2: return "avx2";
+    }
+    return "";
+}
+
+template <int Box>
+void SudokuCandidates::compute(const Mask<Box> *rowUsed, const Mask<Box> *colUsed, const Mask<Box> *boxUsed, Mask<Box> *out)
+{
+#ifdef SUDOKU_X86_KERNELS
+    if constexpr (Box * Box <= 16) {
+        switch (kernel()) {
+        case Kernel::AVX2: computeAvx2<Box>(rowUsed, colUsed, boxUsed, out); return;
+        case Kernel::SSE2: computeSse2<Box>(rowUsed, colUsed, boxUsed, out); return;
+        case Kernel::Scalar: break;
+        }
+    }
+#endif
+    computeScalar<Box>(rowUsed, colUsed, boxUsed, out);
+}
+
+template void SudokuCandidates::compute<3>(const Mask<3> *, const Mask<3> *, const Mask<3> *, Mask<3> *);
+template void SudokuCandidates::compute<4>(const Mask<4> *, const Mask<4> *, const Mask<4> *, Mask<4> *);
+template void SudokuCandidates::compute<5>(const Mask<5> *, const Mask<5> *, const Mask<5> *, Mask<5> *);
@@ -0,0 +1,33 @@
+#ifndef SUDOKUCANDIDATES_H
+#define SUDOKUCANDIDATES_H
+
+#include <cstdint>
+#include <type_traits>
+
+// Candidate masks for every cell of a Box² x Box² board in one pass.
+// On x86 the 9x9 and 16x16 boards are handled a whole row per vector
+// (SSE2, or AVX2 when the CPU has it); everything else uses the scalar loop.
+// The kernel is picked once, the first time it is needed.
+class SudokuCandidates
+{
+public:
+    enum class Kernel { Scalar, SSE2, AVX2 };
+
+    // Extra Mask slots the output buffer needs past the last cell, since
+    // the vector kernels store full registers
+    static constexpr int Padding = 16;
+
+    template <int Box>
+    using Mask = std::conditional_t<(Box * Box <= 16), uint16_t, uint32_t>;
+
+    // out[cell] = digits unused in the cell's row, column and box. Filled
+    // cells get a value too; callers skip them. out must hold
+    // Box⁴ + Padding masks.
+    template <int Box>
+    static void compute(const Mask<Box> *rowUsed, const Mask<Box> *colUsed, const Mask<Box> *boxUsed, Mask<Box> *out);
+
+    static Kernel kernel();
+    static const char *kernelName(Kernel kernel);
+};
+
+#endif // SUDOKUCANDIDATES_H
@@ -64,8 +64,11 @@ SudokuController::SudokuController(QWidget *parent)
         "}"
         );
 
-    // Start with home screen
-    stackedWidget->setCurrentWidget(homeScreen);
+    // Pick up the last unfinished game, otherwise start on the home screen
+    if (gameScreen->resumeSession())
+        stackedWidget->setCurrentWidget(gameScreen);
+    else
+        stackedWidget->setCurrentWidget(homeScreen);
 
     // Debug: Print current sizes
     GameSizes::debugSizes();
@@ -73,13 +76,14 @@ SudokuController::SudokuController(QWidget *parent)
 
 SudokuController::~SudokuController()
 {
-    // Clean up if needed
+    // Keep the game in progress for the next start
+    gameScreen->saveSession();
 }
 
 void SudokuController::onStartGame()
 {
     QString difficulty = homeScreen->selectedDifficulty();
-    gameScreen->startNewGame(difficulty);
+    gameScreen->startNewGame(difficulty, homeScreen->selectedBoxSize(), homeScreen->selectedRules());
     stackedWidget->setCurrentWidget(gameScreen);
 
     // Ensure game screen has focus for keyboard input
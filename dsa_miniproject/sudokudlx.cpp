@@ -0,0 +1,226 @@
+#include "sudokudlx.h"
+#include <algorithm>
+
+namespace {
+
+constexpr int Root = 0;
+
+} // namespace
+
+// Pristine matrix, shared by every solver instance of one box size
+template <int Box>
+struct BasicSudokuDlx<Box>::Matrix {
+    static constexpr int Size = Engine::Size;
+    static constexpr int CellCount = Engine::CellCount;
+    static constexpr int ColumnCount = 4 * CellCount;
+    static constexpr int RowCount = Size * CellCount;
+
+    std::vector<Node> links;
+    std::vector<int> sizes;
+    std::vector<int> rowFirst;   // first node of each candidate row
+
+    Matrix()
+    {
+        links.resize(1 + ColumnCount + RowCount * 4);
+        rowFirst.resize(RowCount);
+        sizes.assign(1 + ColumnCount, 0);
+        for (int c = 0; c <= ColumnCount; ++c) {
+            links[c] = {c - 1, c + 1, c, c, c, -1};
+        }
+        links[Root].left = ColumnCount;
+        links[ColumnCount].right = Root;
+
+        int next = 1 + ColumnCount;
+        for (int cell = 0; cell < CellCount; ++cell) {
+            int r = cell / Size, c = cell % Size, b = r / Box * Box + c / Box;
+            for (int d = 0; d < Size; ++d) {
+                int row = cell * Size + d;
+                int columns[4] = {
+                    1 + cell,
+                    1 + CellCount + r * Size + d,
+                    1 + 2 * CellCount + c * Size + d,
+                    1 + 3 * CellCount + b * Size + d
+                };
+                rowFirst[row] = next;
+                for (int k = 0; k < 4; ++k) {
+                    int node = next + k;
+                    int col = columns[k];
+                    links[node].column = col;
+                    links[node].row = row;
+                    links[node].left = next + (k + 3) % 4;
+                    links[node].right = next + (k + 1) % 4;
+                    links[node].up = links[col].up;
+                    links[node].down = col;
+                    links[links[col].up].down = node;
+                    links[col].up = node;
+                    ++sizes[col];
+                }
+                next += 4;
+            }
+        }
+    }
+};
+
+template <int Box>
+const typename BasicSudokuDlx<Box>::Matrix &BasicSudokuDlx<Box>::matrix()
+{
+    static const Matrix m;
+    return m;
+}
+
+template <int Box>
+BasicSudokuDlx<Box>::BasicSudokuDlx()
+{
+    traceSink = nullptr;
+    solutions = 0;
+    limit = 1;
+    firstSolution.fill(0);
+    givenRows = 0;
+    loaded = false;
+    counters = {0, 0, 0, 0};
+}
+
+template <int Box>
+int BasicSudokuDlx<Box>::countSolutions(const typename Engine::Grid &givens, int limit)
+{
+    traceSink = nullptr;
+    solutions = 0;
+    this->limit = limit;
+    if (reset(givens))
+        search();
+    return solutions;
+}
+
+template <int Box>
+bool BasicSudokuDlx<Box>::solve(const typename Engine::Grid &givens, typename Engine::Grid &solution,
+                                std::vector<SudokuChange> *trace)
+{
+    load(givens);
+    return solve(solution, trace);
+}
+
+template <int Box>
+bool BasicSudokuDlx<Box>::load(const typename Engine::Grid &givens)
+{
+    loaded = reset(givens);
+    return loaded;
+}
+
+template <int Box>
+bool BasicSudokuDlx<Box>::solve(typename Engine::Grid &solution, std::vector<SudokuChange> *trace)
+{
+    traceSink = trace;
+    solutions = 0;
+    limit = 1;
+    if (loaded)
+        search();
+    loaded = false;   // the search leaves the matrix covered
+    traceSink = nullptr;
+    if (solutions == 0) return false;
+    solution = firstSolution;
+    return true;
+}
+
+template <int Box>
+bool BasicSudokuDlx<Box>::reset(const typename Engine::Grid &givens)
+{
+    const Matrix &m = matrix();
+    nodes = m.links;
+    sizes = m.sizes;
+    selected.clear();
+    counters = {0, 0, 0, 0};
+
+    // Givens are pre-selected rows; a column already covered means a clash
+    std::vector<bool> covered(1 + Matrix::ColumnCount, false);
+    for (int cell = 0; cell < Engine::CellCount; ++cell) {
+        int value = givens[cell];
+        if (value == 0) continue;
+        if (value > Engine::Size) return false;
+        int first = m.rowFirst[cell * Engine::Size + value - 1];
+        for (int k = 0; k < 4; ++k) {
+            int col = nodes[first + k].column;
+            if (covered[col]) return false;
+            covered[col] = true;
+            cover(col);
+        }
+        selected.push_back(cell * Engine::Size + value - 1);
+    }
+    givenRows = static_cast<int>(selected.size());
+    return true;
+}
+
+template <int Box>
+void BasicSudokuDlx<Box>::cover(int column)
+{
+    Node &head = nodes[column];
+    nodes[head.right].left = head.left;
+    nodes[head.left].right = head.right;
+    for (int i = head.down; i != column; i = nodes[i].down) {
+        for (int j = nodes[i].right; j != i; j = nodes[j].right) {
+            nodes[nodes[j].down].up = nodes[j].up;
+            nodes[nodes[j].up].down = nodes[j].down;
+            --sizes[nodes[j].column];
+        }
+    }
+}
+
+template <int Box>
+void BasicSudokuDlx<Box>::uncover(int column)
+{
+    Node &head = nodes[column];
+    for (int i = head.up; i != column; i = nodes[i].up) {
+        for (int j = nodes[i].left; j != i; j = nodes[j].left) {
+            ++sizes[nodes[j].column];
+            nodes[nodes[j].down].up = j;
+            nodes[nodes[j].up].down = j;
+        }
+    }
+    nodes[head.right].left = column;
+    nodes[head.left].right = column;
+}
+
+template <int Box>
+void BasicSudokuDlx<Box>::search()
+{
+    if (nodes[Root].right == Root) {
+        if (solutions++ == 0) {
+            for (int row : selected)
+                firstSolution[row / Engine::Size] = row % Engine::Size + 1;
+        }
+        return;
+    }
+
+    // Column with the fewest remaining rows
+    int column = nodes[Root].right;
+    for (int c = nodes[column].right; c != Root; c = nodes[c].right) {
+        if (sizes[c] < sizes[column]) column = c;
+    }
+    if (sizes[column] == 0) return;
+
+    cover(column);
+    for (int r = nodes[column].down; r != column && solutions < limit; r = nodes[r].down) {
+        int row = nodes[r].row;
+        selected.push_back(row);
+        ++counters.nodes;
+        counters.maxDepth = std::max<uint32_t>(counters.maxDepth, static_cast<int>(selected.size()) - givenRows);
+        if (traceSink)
+            traceSink->push_back({static_cast<uint16_t>(row / Engine::Size), static_cast<uint16_t>(row % Engine::Size + 1)});
+        for (int j = nodes[r].right; j != r; j = nodes[j].right)
+            cover(nodes[j].column);
+
+        search();
+
+        for (int j = nodes[r].left; j != r; j = nodes[j].left)
+            uncover(nodes[j].column);
+        selected.pop_back();
+        if (solutions < limit)
+            ++counters.backtracks;
+        if (traceSink && solutions < limit)
+            traceSink->push_back({static_cast<uint16_t>(row / Engine::Size), 0});
+    }
+    uncover(column);
+}
+
+template class BasicSudokuDlx<3>;
+template class BasicSudokuDlx<4>;
+template class BasicSudokuDlx<5>;
@@ -0,0 +1,68 @@
+#ifndef SUDOKUDLX_H
+#define SUDOKUDLX_H
+
+#include <vector>
+#include "sudokuengine.h"
+
+// Dancing Links (Knuth's Algorithm X) exact-cover solver.
+// Sudoku maps to 4 * CellCount constraint columns (cell, row-digit,
+// column-digit, box-digit) and Size * CellCount candidate rows, 324 and 729
+// for the classic board. The matrix is built once per box size and copied
+// for each call, so an early stop never needs to unwind the links.
+template <int Box>
+class BasicSudokuDlx
+{
+public:
+    using Engine = BasicSudokuEngine<Box>;
+
+    BasicSudokuDlx();
+
+    // Counts solutions, stopping as soon as limit is reached (2 is enough
+    // to tell a unique puzzle from an ambiguous one)
+    int countSolutions(const typename Engine::Grid &givens, int limit = 2);
+
+    // Finds one solution; optionally records placements and clears like SudokuEngine
+    bool solve(const typename Engine::Grid &givens, typename Engine::Grid &solution,
+               std::vector<SudokuChange> *trace = nullptr);
+
+    // The same in two phases, so the matrix setup can be timed on its own:
+    // load() returns false if the givens clash, solve() then searches
+    bool load(const typename Engine::Grid &givens);
+    bool solve(typename Engine::Grid &solution, std::vector<SudokuChange> *trace = nullptr);
+
+    // Effort of the last call, counted the same way as the engine's
+    const typename Engine::Stats &stats() const { return counters; }
+
+private:
+    struct Node {
+        int left, right, up, down;
+        int column;
+        int row;    // candidate index cell * Size + digit - 1, -1 for headers
+    };
+    struct Matrix;
+    static const Matrix &matrix();
+
+    std::vector<Node> nodes;
+    std::vector<int> sizes;
+    std::vector<int> selected;   // candidate rows chosen so far
+    int givenRows;               // leading entries of selected that are givens
+    bool loaded;                 // load() succeeded
+    std::vector<SudokuChange> *traceSink;
+    int solutions;
+    int limit;
+    typename Engine::Grid firstSolution;
+    typename Engine::Stats counters;
+
+    bool reset(const typename Engine::Grid &givens);
+    void cover(int column);
+    void uncover(int column);
+    void search();
+};
+
+extern template class BasicSudokuDlx<3>;
+extern template class BasicSudokuDlx<4>;
+extern template class BasicSudokuDlx<5>;
+
+using SudokuDlx = BasicSudokuDlx<3>;
+
+#endif // SUDOKUDLX_H
@@ -0,0 +1,292 @@
+#include "sudokuengine.h"
+#include "sudokucandidates.h"
+#include <algorithm>
+
+namespace {
+
+template <int Box>
+struct Tables {
+    static constexpr int Size = Box * Box;
+    static constexpr int CellCount = Size * Size;
+
+    uint8_t row[CellCount];
+    uint8_t col[CellCount];
+    uint8_t box[CellCount];
+    uint16_t units[3 * Size][Size];   // rows, then columns, then boxes
+};
+
+template <int Box>
+constexpr Tables<Box> makeTables()
+{
+    constexpr int Size = Box * Box;
+    Tables<Box> t{};
+    for (int i = 0; i < Size * Size; ++i) {
+        int r = i / Size, c = i % Size;
+        t.row[i] = r;
+        t.col[i] = c;
+        t.box[i] = r / Box * Box + c / Box;
+    }
+    for (int u = 0; u < Size; ++u) {
+        for (int k = 0; k < Size; ++k) {
+            t.units[u][k] = u * Size + k;
+            t.units[Size + u][k] = k * Size + u;
+            t.units[2 * Size + u][k] = (u / Box * Box + k / Box) * Size + u % Box * Box + k % Box;
+        }
+    }
+    return t;
+}
+
+template <int Box>
+constexpr Tables<Box> tables = makeTables<Box>();
+
+template <typename Mask>
+constexpr Mask allDigits(int size) { return static_cast<Mask>((uint64_t(1) << size) - 1); }
+
+inline int lowestDigit(uint32_t mask) { return __builtin_ctz(mask) + 1; }
+inline bool isSingle(uint32_t mask) { return (mask & (mask - 1)) == 0; }
+inline int bitCount(uint32_t mask) { return __builtin_popcount(mask); }
+
+} // namespace
+
+template <int Box>
+BasicSudokuEngine<Box>::BasicSudokuEngine()
+{
+    cells.fill(0);
+    rowUsed.fill(0);
+    colUsed.fill(0);
+    boxUsed.fill(0);
+    changeSink = nullptr;
+    filled = 0;
+    started = false;
+    needBranch = false;
+    state = Status::Unsolvable;
+    counters = {0, 0, 0, 0};
+}
+
+template <int Box>
+bool BasicSudokuEngine<Box>::load(const Grid &givens)
+{
+    cells.fill(0);
+    rowUsed.fill(0);
+    colUsed.fill(0);
+    boxUsed.fill(0);
+    trail.clear();
+    frames.clear();
+    changeSink = nullptr;
+    filled = 0;
+    started = false;
+    needBranch = false;
+    state = Status::Searching;
+    counters = {0, 0, 0, 0};
+
+    for (int i = 0; i < CellCount; ++i) {
+        int value = givens[i];
+        if (value == 0) continue;
+        if (value > Size || !assign(i, value)) {
+            state = Status::Unsolvable;
+            return false;
+        }
+    }
+    trail.clear();   // givens are never undone
+    return true;
+}
+
+template <int Box>
+typename BasicSudokuEngine<Box>::Status BasicSudokuEngine<Box>::solve()
+{
+    changeSink = nullptr;
+    while (state == Status::Searching)
+        advance();
+    return state;
+}
+
+template <int Box>
+typename BasicSudokuEngine<Box>::Status BasicSudokuEngine<Box>::solve(std::vector<Change> &trace)
+{
+    changeSink = &trace;
+    while (state == Status::Searching)
+        advance();
+    changeSink = nullptr;
+    return state;
+}
+
+template <int Box>
+bool BasicSudokuEngine<Box>::solveBySingles()
+{
+    if (state != Status::Searching || started) return state == Status::Solved;
+    changeSink = nullptr;
+    return advance() == Status::Solved;
+}
+
+template <int Box>
+typename BasicSudokuEngine<Box>::Mask BasicSudokuEngine<Box>::candidates(int cell) const
+{
+    return allDigits<Mask>(Size) & ~(rowUsed[tables<Box>.row[cell]] | colUsed[tables<Box>.col[cell]] | boxUsed[tables<Box>.box[cell]]);
+}
+
+template <int Box>
+bool BasicSudokuEngine<Box>::assign(int cell, int value)
+{
+    if (cells[cell] != 0) return cells[cell] == value;
+    Mask bit = Mask(1) << (value - 1);
+    if (!(candidates(cell) & bit)) return false;
+
+    cells[cell] = value;
+    rowUsed[tables<Box>.row[cell]] |= bit;
+    colUsed[tables<Box>.col[cell]] |= bit;
+    boxUsed[tables<Box>.box[cell]] |= bit;
+    trail.push_back(cell);
+    ++filled;
+    if (changeSink)
+        changeSink->push_back({static_cast<uint16_t>(cell), static_cast<uint16_t>(value)});
+    return true;
+}
+
+template <int Box>
+void BasicSudokuEngine<Box>::undoTo(uint32_t mark)
+{
+    while (trail.size() > mark) {
+        int cell = trail.back();
+        trail.pop_back();
+        Mask mask = ~(Mask(1) << (cells[cell] - 1));
+        rowUsed[tables<Box>.row[cell]] &= mask;
+        colUsed[tables<Box>.col[cell]] &= mask;
+        boxUsed[tables<Box>.box[cell]] &= mask;
+        cells[cell] = 0;
+        --filled;
+        if (changeSink)
+            changeSink->push_back({static_cast<uint16_t>(cell), 0});
+    }
+}
+
+template <int Box>
+bool BasicSudokuEngine<Box>::propagate()
+{
+    // Candidate masks come from one whole-board kernel pass. Naked singles
+    // are placed from that snapshot until none are left, so the hidden
+    // singles pass starts from fresh masks. Placements inside a pass only
+    // shrink the real candidates: a stale mask can hide a single until the
+    // next round but never invent one.
+    Mask cand[CellCount + SudokuCandidates::Padding];
+    bool progress = true;
+    while (progress && filled < CellCount) {
+        progress = false;
+        ++counters.rounds;
+
+        // Naked singles: a cell with exactly one candidate
+        bool placed = true;
+        while (placed && filled < CellCount) {
+            placed = false;
+            SudokuCandidates::compute<Box>(rowUsed.data(), colUsed.data(), boxUsed.data(), cand);
+            for (int i = 0; i < CellCount; ++i) {
+                if (cells[i]) continue;
+                if (!cand[i]) return false;
+                if (isSingle(cand[i])) {
+                    if (!assign(i, lowestDigit(cand[i]))) return false;   // a peer took the digit this pass
+                    placed = true;
+                }
+            }
+        }
+        if (filled == CellCount) break;
+
+        // Hidden singles: a digit with exactly one possible cell in a unit
+        for (int u = 0; u < 3 * Size; ++u) {
+            const uint16_t *unit = tables<Box>.units[u];
+            Mask used = 0, once = 0, twice = 0;
+            for (int k = 0; k < Size; ++k) {
+                int cell = unit[k];
+                if (cells[cell]) {
+                    used |= 1u << (cells[cell] - 1);
+                } else {
+                    twice |= once & cand[cell];
+                    once |= cand[cell];
+                }
+            }
+            if ((used | once) != allDigits<Mask>(Size)) return false;   // some digit has nowhere to go
+
+            Mask hidden = once & ~twice & ~used;   // stale masks may still list placed digits
+            while (hidden) {
+                int value = lowestDigit(hidden);
+                hidden &= hidden - 1;
+                Mask bit = Mask(1) << (value - 1);
+                for (int k = 0; k < Size; ++k) {
+                    int cell = unit[k];
+                    if (cells[cell] == 0 && (candidates(cell) & bit)) {
+                        assign(cell, value);
+                        progress = true;
+                        break;
+                    }
+                    if (k == Size - 1) return false;   // placement above stole the last spot
+                }
+            }
+        }
+    }
+    return true;
+}
+
+template <int Box>
+int BasicSudokuEngine<Box>::pickCell(Mask &cand) const
+{
+    Mask all[CellCount + SudokuCandidates::Padding];
+    SudokuCandidates::compute<Box>(rowUsed.data(), colUsed.data(), boxUsed.data(), all);
+    int best = -1;
+    int bestCount = Size + 1;
+    for (int i = 0; i < CellCount; ++i) {
+        if (cells[i]) continue;
+        int count = bitCount(all[i]);
+        if (count < bestCount) {
+            best = i;
+            bestCount = count;
+            cand = all[i];
+            if (count <= 2) break;
+        }
+    }
+    return best;
+}
+
+template <int Box>
+typename BasicSudokuEngine<Box>::Status BasicSudokuEngine<Box>::advance()
+{
+    if (!started) {
+        started = true;
+        if (!propagate()) state = Status::Unsolvable;
+        else if (filled == CellCount) state = Status::Solved;
+        else needBranch = true;
+        return state;
+    }
+
+    if (needBranch) {
+        Frame frame;
+        Mask cand = 0;
+        frame.cell = pickCell(cand);
+        frame.remaining = cand;
+        frame.trailMark = trail.size();
+        frames.push_back(frame);
+        counters.maxDepth = std::max<uint32_t>(counters.maxDepth, frames.size());
+        needBranch = false;
+    }
+
+    Frame &top = frames.back();
+    undoTo(top.trailMark);
+    if (!top.remaining) {
+        // Every candidate failed: backtrack into the previous guess
+        frames.pop_back();
+        if (frames.empty()) state = Status::Unsolvable;
+        return state;
+    }
+
+    int value = lowestDigit(top.remaining);
+    top.remaining &= top.remaining - 1;
+    ++counters.nodes;
+    if (assign(top.cell, value) && propagate()) {
+        if (filled == CellCount) state = Status::Solved;
+        else needBranch = true;
+    } else {
+        ++counters.backtracks;
+    }
+    return state;
+}
+
+template class BasicSudokuEngine<3>;
+template class BasicSudokuEngine<4>;
+template class BasicSudokuEngine<5>;
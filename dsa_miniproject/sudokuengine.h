@@ -0,0 +1,95 @@
+#ifndef SUDOKUENGINE_H
+#define SUDOKUENGINE_H
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// One placement or clear recorded during a search. Packed into two bytes,
+// which is enough for every supported board (625 cells, digits up to 25).
+struct SudokuChange {
+    uint16_t cell : 10;
+    uint16_t value : 6;   // 0 means clear
+};
+
+// Constraint-propagation Sudoku engine for a Box² x Box² board.
+// Keeps a bitmask of used digits per row, column and box, always branches on
+// the most constrained cell and propagates naked and hidden singles after
+// every placement. The search is an explicit stack; solve() can optionally
+// record every placement and clear it makes so the search can be replayed.
+// Each box size is its own instantiation, so loop bounds and the mask width
+// are compile-time constants.
+template <int Box>
+class BasicSudokuEngine
+{
+public:
+    static constexpr int BoxSize = Box;
+    static constexpr int Size = Box * Box;
+    static constexpr int CellCount = Size * Size;
+
+    using Mask = std::conditional_t<(Size <= 16), uint16_t, uint32_t>;
+    using Grid = std::array<uint8_t, CellCount>;   // row-major, 0 means empty
+    using Change = SudokuChange;
+
+    enum class Status { Searching, Solved, Unsolvable };
+
+    // Search effort since the last load()
+    struct Stats {
+        uint64_t nodes;        // guesses tried
+        uint64_t backtracks;   // guesses that led to a contradiction
+        uint64_t rounds;       // propagation passes over the board (0 for Dancing Links)
+        uint32_t maxDepth;     // most guesses open at once
+    };
+
+    BasicSudokuEngine();
+
+    // Returns false (and becomes Unsolvable) if the givens already conflict
+    bool load(const Grid &givens);
+    Status solve();
+    Status solve(std::vector<Change> &trace);
+
+    // Singles propagation only, no guessing. True if that fills the board,
+    // which also proves the solution is unique; otherwise solve() can
+    // carry on from where it stopped.
+    bool solveBySingles();
+
+    Status status() const { return state; }
+    const Grid &grid() const { return cells; }
+    const Stats &stats() const { return counters; }
+
+private:
+    struct Frame {
+        uint16_t cell;
+        Mask remaining;         // candidates not tried yet
+        uint32_t trailMark;     // trail size before the guess
+    };
+
+    Grid cells;
+    std::array<Mask, Size> rowUsed;
+    std::array<Mask, Size> colUsed;
+    std::array<Mask, Size> boxUsed;
+    std::vector<uint16_t> trail;
+    std::vector<Frame> frames;
+    std::vector<Change> *changeSink;
+    int filled;
+    bool started;
+    bool needBranch;
+    Status state;
+    Stats counters;
+
+    Mask candidates(int cell) const;
+    bool assign(int cell, int value);
+    void undoTo(uint32_t mark);
+    bool propagate();
+    int pickCell(Mask &cand) const;
+    Status advance();
+};
+
+extern template class BasicSudokuEngine<3>;
+extern template class BasicSudokuEngine<4>;
+extern template class BasicSudokuEngine<5>;
+
+using SudokuEngine = BasicSudokuEngine<3>;
+
+#endif // SUDOKUENGINE_H
@@ -0,0 +1,232 @@
+#include "sudokugenerator.h"
+#include "sudokudlx.h"
+#include "sudokurater.h"
+#include <utility>
+
+namespace {
+
+using Technique = SudokuLogic::Technique;
+
+// Clue floor and the range of hardest technique each band accepts
+struct Band {
+    int clues;
+    Technique least;
+    Technique most;
+};
+
+Band band(SudokuGenerator::Difficulty difficulty)
+{
+    switch (difficulty) {
+    case SudokuGenerator::Difficulty::Easy: return {36, Technique::HiddenSingle, Technique::NakedSingle};
+    case SudokuGenerator::Difficulty::Medium: return {26, Technique::LockedCandidates, Technique::HiddenTriple};
+    case SudokuGenerator::Difficulty::Hard: return {17, Technique::XWing, Technique::Trial};
+    }
+    return {30, Technique::HiddenSingle, Technique::Trial};
+}
+
+// Fresh grids dug before settling for the best one seen
+const int MaxAttempts = 16;
+
+// Share of the cells kept as clues on boards without a technique rating
+double clueShare(SudokuGenerator::Difficulty difficulty)
+{
+    switch (difficulty) {
+    case SudokuGenerator::Difficulty::Easy: return 0.55;
+    case SudokuGenerator::Difficulty::Medium: return 0.48;
+    case SudokuGenerator::Difficulty::Hard: return 0.42;
+    }
+    return 0.48;
+}
+
+template <int Box>
+typename BasicSudokuEngine<Box>::Grid filledGrid(SudokuRandom &random)
+{
+    using Engine = BasicSudokuEngine<Box>;
+    constexpr int Size = Engine::Size;
+    typename Engine::Grid grid;
+    grid.fill(0);
+
+    auto shuffle = [&random](int *values, int count) {
+        for (int i = count - 1; i > 0; --i)
+            std::swap(values[i], values[random.bounded(i + 1)]);
+    };
+
+    if (Box > 3) {
+        // Search from a near-empty board thrashes at this size. Start from
+        // the shifted base pattern instead and shuffle digits, bands, stacks
+        // and the rows and columns within them, which keeps it valid.
+        int digits[Size], rows[Size], cols[Size], bands[Box], stacks[Box];
+        for (int i = 0; i < Size; ++i)
+            digits[i] = i + 1;
+        for (int i = 0; i < Box; ++i)
+            bands[i] = stacks[i] = i;
+        shuffle(digits, Size);
+        shuffle(bands, Box);
+        shuffle(stacks, Box);
+        for (int b = 0; b < Box; ++b) {
+            int inner[Box];
+            for (int i = 0; i < Box; ++i)
+                inner[i] = i;
+            shuffle(inner, Box);
+            for (int i = 0; i < Box; ++i)
+                rows[b * Box + i] = bands[b] * Box + inner[i];
+            shuffle(inner, Box);
+            for (int i = 0; i < Box; ++i)
+                cols[b * Box + i] = stacks[b] * Box + inner[i];
+        }
+        for (int r = 0; r < Size; ++r) {
+            for (int c = 0; c < Size; ++c) {
+                int pr = rows[r], pc = cols[c];
+                grid[r * Size + c] = digits[(Box * (pr % Box) + pr / Box + pc) % Size];
+            }
+        }
+        return grid;
+    }
+
+    // The diagonal boxes never constrain each other, so shuffle them
+    // independently and let the engine complete the rest
+    for (int box = 0; box < Box; ++box) {
+        int digits[Size];
+        for (int i = 0; i < Size; ++i)
+            digits[i] = i + 1;
+        shuffle(digits, Size);
+        for (int k = 0; k < Size; ++k)
+            grid[(box * Box + k / Box) * Size + box * Box + k % Box] = digits[k];
+    }
+
+    Engine engine;
+    engine.load(grid);
+    engine.solve();
+    return engine.grid();
+}
+
+// Digs clues in random order down to a share of the board. Exact solution
+// counting blows up on 25x25, so a removal is kept only while the puzzle
+// still falls to singles alone, which is enough to prove it unique.
+template <int Box>
+void digBySingles(typename BasicSudokuEngine<Box>::Grid &givens, int target, SudokuRandom &random)
+{
+    constexpr int CellCount = BasicSudokuEngine<Box>::CellCount;
+    int order[CellCount];
+    for (int i = 0; i < CellCount; ++i)
+        order[i] = i;
+    for (int i = CellCount - 1; i > 0; --i)
+        std::swap(order[i], order[random.bounded(i + 1)]);
+
+    BasicSudokuEngine<Box> engine;
+    int clues = CellCount;
+    for (int i = 0; i < CellCount && clues > target; ++i) {
+        int cell = order[i];
+        uint8_t value = givens[cell];
+        givens[cell] = 0;
+        if (engine.load(givens) && engine.solveBySingles())
+            --clues;
+        else
+            givens[cell] = value;
+    }
+}
+
+template <int Box>
+SudokuGenerator::Board generateBoxed(uint64_t seed, SudokuGenerator::Difficulty difficulty)
+{
+    using Engine = BasicSudokuEngine<Box>;
+    SudokuRandom random(seed);
+    typename Engine::Grid solution = filledGrid<Box>(random);
+    typename Engine::Grid givens = solution;
+    digBySingles<Box>(givens, static_cast<int>(Engine::CellCount * clueShare(difficulty)), random);
+
+    SudokuGenerator::Board board;
+    board.box = Box;
+    board.seed = seed;
+    board.givens.assign(givens.begin(), givens.end());
+    board.solution.assign(solution.begin(), solution.end());
+    return board;
+}
+
+} // namespace
+
+uint64_t SudokuRandom::next()
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+int SudokuRandom::bounded(int n)
+{
+    return static_cast<int>(((next() >> 32) * static_cast<uint64_t>(n)) >> 32);
+}
+
+SudokuGenerator::Puzzle SudokuGenerator::generate(uint64_t seed, Difficulty difficulty)
+{
+    SudokuRandom random(seed);
+    Band target = band(difficulty);
+    Puzzle best;
+    for (int attempt = 0; attempt < MaxAttempts; ++attempt) {
+        Puzzle puzzle;
+        puzzle.seed = seed;
+        puzzle.difficulty = difficulty;
+        puzzle.solution = filledGrid<3>(random);
+        dig(puzzle, random);
+        if (puzzle.hardest >= target.least)
+            return puzzle;
+        if (attempt == 0 || puzzle.score > best.score)
+            best = puzzle;
+    }
+    return best;
+}
+
+void SudokuGenerator::dig(Puzzle &puzzle, SudokuRandom &random)
+{
+    Band target = band(puzzle.difficulty);
+    puzzle.givens = puzzle.solution;
+    puzzle.clues = SudokuEngine::CellCount;
+
+    int order[SudokuEngine::CellCount];
+    for (int i = 0; i < SudokuEngine::CellCount; ++i)
+        order[i] = i;
+    for (int i = SudokuEngine::CellCount - 1; i > 0; --i)
+        std::swap(order[i], order[random.bounded(i + 1)]);
+
+    SudokuDlx dlx;
+    SudokuRater::Rating rating = SudokuRater::rate(puzzle.givens);
+    for (int i = 0; i < SudokuEngine::CellCount && puzzle.clues > target.clues; ++i) {
+        int cell = order[i];
+        uint8_t value = puzzle.givens[cell];
+        puzzle.givens[cell] = 0;
+        if (dlx.countSolutions(puzzle.givens, 2) == 1) {
+            // Rating is only needed when the band caps the technique
+            SudokuRater::Rating next = rating;
+            if (target.most != Technique::Trial)
+                next = SudokuRater::rate(puzzle.givens);
+            if (next.hardest <= target.most) {
+                rating = next;
+                --puzzle.clues;
+                continue;
+            }
+        }
+        puzzle.givens[cell] = value;
+    }
+
+    if (target.most == Technique::Trial)
+        rating = SudokuRater::rate(puzzle.givens);
+    puzzle.score = rating.score;
+    puzzle.hardest = rating.hardest;
+}
+
+SudokuGenerator::Board SudokuGenerator::generateBoard(int box, uint64_t seed, Difficulty difficulty)
+{
+    switch (box) {
+    case 4: return generateBoxed<4>(seed, difficulty);
+    case 5: return generateBoxed<5>(seed, difficulty);
+    }
+
+    Puzzle puzzle = generate(seed, difficulty);
+    Board board;
+    board.box = 3;
+    board.seed = seed;
+    board.givens.assign(puzzle.givens.begin(), puzzle.givens.end());
+    board.solution.assign(puzzle.solution.begin(), puzzle.solution.end());
+    return board;
+}
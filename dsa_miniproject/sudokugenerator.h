@@ -0,0 +1,57 @@
+#ifndef SUDOKUGENERATOR_H
+#define SUDOKUGENERATOR_H
+
+#include <cstdint>
+#include <vector>
+#include "sudokuengine.h"
+#include "sudokulogic.h"
+
+// Small deterministic PRNG (SplitMix64), so a puzzle can be rebuilt from its seed
+class SudokuRandom
+{
+public:
+    explicit SudokuRandom(uint64_t seed) : state(seed) {}
+    uint64_t next();
+    int bounded(int n);   // uniform in [0, n)
+
+private:
+    uint64_t state;
+};
+
+// Builds a fresh filled grid, then digs clues out in random order, keeping
+// only removals after which the puzzle still has exactly one solution and
+// stays within the difficulty band's hardest allowed technique. Grids that
+// end up too easy for the band are thrown away and dug again.
+class SudokuGenerator
+{
+public:
+    enum class Difficulty { Easy, Medium, Hard };
+
+    struct Puzzle {
+        SudokuEngine::Grid givens;
+        SudokuEngine::Grid solution;
+        uint64_t seed;
+        Difficulty difficulty;
+        int clues;
+        int score;                          // SudokuRater score
+        SudokuLogic::Technique hardest;
+    };
+
+    // Any board size; 16x16 and 25x25 are not rated and are dug down to a
+    // share of the cells instead
+    struct Board {
+        int box;
+        std::vector<uint8_t> givens;     // row-major, box^4 cells
+        std::vector<uint8_t> solution;
+        uint64_t seed;
+    };
+
+    // Same seed and difficulty always give the same puzzle
+    static Puzzle generate(uint64_t seed, Difficulty difficulty);
+    static Board generateBoard(int box, uint64_t seed, Difficulty difficulty);
+
+private:
+    static void dig(Puzzle &puzzle, SudokuRandom &random);
+};
+
+#endif // SUDOKUGENERATOR_H
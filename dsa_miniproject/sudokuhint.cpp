@@ -0,0 +1,190 @@
+#include "sudokuhint.h"
+#include "sudokumodel.h"
+#include <QStringList>
+
+SudokuHint::SudokuHint(SudokuModel *model, QObject *parent) : QObject(parent)
+{
+    this->model = model;
+    solution.fill(0);
+    solvable = false;
+    stale = true;
+    connect(model, &SudokuModel::modelReset, this, &SudokuHint::onModelReset);
+    connect(model, &SudokuModel::cellChanged, this, &SudokuHint::onCellChanged);
+    connect(model, &SudokuModel::cellsChanged, this, &SudokuHint::onCellsChanged);
+    onModelReset();
+}
+
+bool SudokuHint::isAvailable() const
+{
+    return model->boxSize() == 3 && model->constraints().isClassic() && solvable && !model->isSolved();
+}
+
+void SudokuHint::onModelReset()
+{
+    stale = true;
+    solvable = false;
+    if (model->boxSize() != 3 || !model->constraints().isClassic()) return;
+
+    // Mistakes are judged against the solution of the givens alone
+    SudokuEngine::Grid givens;
+    for (int cell = 0; cell < SudokuEngine::CellCount; ++cell)
+        givens[cell] = model->isGiven(cell) ? model->value(cell) : 0;
+    SudokuEngine engine;
+    solvable = engine.load(givens) && engine.solve() == SudokuEngine::Status::Solved;
+    solution = engine.grid();
+}
+
+void SudokuHint::onCellChanged(int cell, int value)
+{
+    if (stale) return;
+    bool follows = value != 0 && value == solution[cell] && logic.value(cell) == 0
+                && (logic.candidates(cell) & (1u << (value - 1)));
+    if (!follows) {
+        stale = true;
+        return;
+    }
+    SudokuLogic::Step step;
+    step.placements.push_back({static_cast<uint16_t>(cell), static_cast<uint16_t>(value)});
+    logic.apply(step);
+}
+
+void SudokuHint::onCellsChanged()
+{
+    stale = true;
+}
+
+SudokuHint::Hint SudokuHint::next()
+{
+    Hint hint;
+    hint.kind = Hint::Kind::Unavailable;
+    hint.technique = SudokuLogic::Technique::Trial;
+    if (!isAvailable()) {
+        if (model->boxSize() != 3) hint.text = "Hints are only available on 9x9 boards.";
+        else if (!solvable) hint.text = "These givens have no solution.";
+        else hint.text = "The puzzle is already solved.";
+        return hint;
+    }
+
+    // Wrong entries first: any deduction built on them would be nonsense
+    for (int cell = 0; cell < SudokuEngine::CellCount; ++cell) {
+        int value = model->value(cell);
+        if (value && value != solution[cell])
+            hint.targets.push_back(cell);
+    }
+    if (!hint.targets.empty()) {
+        hint.kind = Hint::Kind::Mistake;
+        hint.text = hint.targets.size() == 1
+                        ? QString("%1 does not match the solution.").arg(cellName(hint.targets[0]))
+                        : QString("%1 entries do not match the solution.").arg(hint.targets.size());
+        return hint;
+    }
+
+    if (stale) {
+        SudokuEngine::Grid grid;
+        for (int cell = 0; cell < SudokuEngine::CellCount; ++cell)
+            grid[cell] = model->value(cell);
+        logic.load(grid);
+        stale = false;
+    }
+
+    SudokuLogic::Step step;
+    if (logic.findStep(step)) {
+        hint.kind = Hint::Kind::Step;
+        hint.technique = step.technique;
+        hint.pattern.assign(step.cells.begin(), step.cells.end());
+        for (const SudokuEngine::Change &change : step.placements)
+            hint.targets.push_back(change.cell);
+        hint.placements = step.placements;
+        for (const SudokuLogic::Elimination &elimination : step.eliminations)
+            hint.targets.push_back(elimination.cell);
+        hint.text = describe(step);
+
+        // Eliminations stay in the candidate grid; placements wait for the player
+        step.placements.clear();
+        logic.apply(step);
+        return hint;
+    }
+
+    // Out of techniques: reveal the most constrained cell
+    int best = -1;
+    for (int cell = 0; cell < SudokuEngine::CellCount; ++cell) {
+        if (logic.value(cell)) continue;
+        if (best < 0 || __builtin_popcount(logic.candidates(cell)) < __builtin_popcount(logic.candidates(best)))
+            best = cell;
+    }
+    hint.kind = Hint::Kind::Guess;
+    hint.targets.push_back(best);
+    hint.placements.push_back({static_cast<uint16_t>(best), solution[best]});
+    hint.text = QString("No technique up to %1 applies here. Searching shows %2 is %3.")
+                    .arg(SudokuLogic::techniqueName(SudokuLogic::Technique::XYChain))
+                    .arg(cellName(best))
+                    .arg(int(solution[best]));
+    return hint;
+}
+
+QString SudokuHint::cellName(int cell)
+{
+    return QString("r%1c%2").arg(cell / 9 + 1).arg(cell % 9 + 1);
+}
+
+QString SudokuHint::unitName(int unit)
+{
+    if (unit < 9) return QString("row %1").arg(unit + 1);
+    if (unit < 18) return QString("column %1").arg(unit - 9 + 1);
+    return QString("box %1").arg(unit - 18 + 1);
+}
+
+QString SudokuHint::digitList(uint16_t digits)
+{
+    QStringList list;
+    for (int digit = 1; digit <= 9; ++digit)
+        if (digits & (1u << (digit - 1))) list << QString::number(digit);
+    return list.join("/");
+}
+
+QString SudokuHint::describe(const SudokuLogic::Step &step) const
+{
+    QStringList pattern;
+    for (uint8_t cell : step.cells)
+        pattern << cellName(cell);
+    QStringList targets;
+    uint16_t removed = 0;
+    for (const SudokuLogic::Elimination &elimination : step.eliminations) {
+        targets << cellName(elimination.cell);
+        removed |= elimination.digits;
+    }
+
+    QString name = SudokuLogic::techniqueName(step.technique);
+    QString digits = digitList(step.digits);
+    switch (step.technique) {
+    case SudokuLogic::Technique::HiddenSingle:
+        return QString("%1: in %2, %3 fits only in %4.")
+            .arg(name, unitName(step.unit), digits, pattern.join(", "));
+    case SudokuLogic::Technique::NakedSingle:
+        return QString("%1: %2 has one candidate left, %3.").arg(name, pattern.join(", "), digits);
+    case SudokuLogic::Technique::LockedCandidates:
+        return QString("%1: in %2, %3 is confined to %4, so it can be removed from %5.")
+            .arg(name, unitName(step.unit), digits, pattern.join(", "), targets.join(", "));
+    case SudokuLogic::Technique::NakedPair:
+    case SudokuLogic::Technique::NakedTriple:
+        return QString("%1: %2 in %3 hold only %4, so those digits can be removed from %5.")
+            .arg(name, pattern.join(", "), unitName(step.unit), digits, targets.join(", "));
+    case SudokuLogic::Technique::HiddenPair:
+    case SudokuLogic::Technique::HiddenTriple:
+        return QString("%1: in %2, %3 fit only in %4, so %5 can be removed from those cells.")
+            .arg(name, unitName(step.unit), digits, pattern.join(", "), digitList(removed));
+    case SudokuLogic::Technique::XWing:
+    case SudokuLogic::Technique::Swordfish:
+        return QString("%1 on %2: %3 cover every place for %2 in their lines, so it can be removed from %4.")
+            .arg(name, digits, pattern.join(", "), targets.join(", "));
+    case SudokuLogic::Technique::XYWing:
+        return QString("%1: pivot %2 with wings %3 and %4; one wing must be %5, so it can be removed from %6.")
+            .arg(name, pattern.value(0), pattern.value(1), pattern.value(2), digitList(removed), targets.join(", "));
+    case SudokuLogic::Technique::XYChain:
+        return QString("%1: along %2 one end must be %3, so it can be removed from %4.")
+            .arg(name, pattern.join(" - "), digits, targets.join(", "));
+    case SudokuLogic::Technique::Trial:
+        break;
+    }
+    return name;
+}
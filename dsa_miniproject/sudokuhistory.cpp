@@ -0,0 +1,126 @@
+#include "sudokuhistory.h"
+#include "sudokumodel.h"
+
+SudokuHistory::SudokuHistory()
+{
+    model = nullptr;
+    cursor = 0;
+}
+
+void SudokuHistory::setModel(SudokuModel *model)
+{
+    this->model = model;
+    clear();
+}
+
+void SudokuHistory::clear()
+{
+    ops.clear();
+    cursor = 0;
+}
+
+bool SudokuHistory::setValue(int cell, int value)
+{
+    return setValues({{static_cast<uint16_t>(cell), static_cast<uint16_t>(value)}});
+}
+
+bool SudokuHistory::setValues(const std::vector<SudokuChange> &changes)
+{
+    // Final value of every cell the batch touches, later entries winning
+    std::vector<uint8_t> after = model->cells();
+    for (const SudokuChange &change : changes) {
+        if (!model->isGiven(change.cell))
+            after[change.cell] = change.value <= model->size() ? change.value : 0;
+    }
+
+    // One op per changed cell; resetting after[] skips repeats of a cell
+    std::vector<Op> move;
+    std::vector<SudokuChange> applied;
+    for (const SudokuChange &change : changes) {
+        int cell = change.cell;
+        int old = model->value(cell);
+        if (old == after[cell]) continue;
+        move.push_back({change.cell, static_cast<uint16_t>(old ^ after[cell]), move.empty()});
+        applied.push_back({change.cell, after[cell]});
+        after[cell] = old;
+    }
+    if (move.empty()) return false;
+
+    // A new move drops whatever could still be redone
+    ops.resize(cursor);
+    ops.insert(ops.end(), move.begin(), move.end());
+    cursor = ops.size();
+    model->setValues(applied);
+    return true;
+}
+
+bool SudokuHistory::clearEntries()
+{
+    std::vector<SudokuChange> changes;
+    for (int cell = 0; cell < model->cellCount(); ++cell) {
+        if (!model->isGiven(cell) && model->value(cell))
+            changes.push_back({static_cast<uint16_t>(cell), 0});
+    }
+    return setValues(changes);
+}
+
+bool SudokuHistory::undo()
+{
+    if (!canUndo()) return false;
+    size_t begin = cursor;
+    while (!ops[--begin].first) {}
+    replay(begin, cursor);
+    cursor = begin;
+    return true;
+}
+
+bool SudokuHistory::redo()
+{
+    if (!canRedo()) return false;
+    size_t end = cursor + 1;
+    while (end < ops.size() && !ops[end].first)
+        ++end;
+    replay(cursor, end);
+    cursor = end;
+    return true;
+}
+
+void SudokuHistory::replay(size_t begin, size_t end)
+{
+    // XOR is its own inverse, so undo and redo apply the same deltas
+    std::vector<SudokuChange> changes;
+    changes.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+        int value = model->value(ops[i].cell) ^ ops[i].delta;
+        changes.push_back({ops[i].cell, static_cast<uint16_t>(value)});
+    }
+    model->setValues(changes);
+}
+
+std::vector<uint16_t> SudokuHistory::packedOps() const
+{
+    std::vector<uint16_t> packed;
+    packed.reserve(ops.size());
+    for (const Op &op : ops)
+        packed.push_back(op.cell | op.delta << 10 | op.first << 15);
+    return packed;
+}
+
+bool SudokuHistory::restore(const std::vector<uint16_t> &packed, size_t position)
+{
+    clear();
+    if (position > packed.size() || (!packed.empty() && !(packed[0] >> 15))) return false;
+    // The cursor has to sit between moves, or undo would split one
+    if (position < packed.size() && !(packed[position] >> 15)) return false;
+    for (uint16_t word : packed) {
+        int cell = word & 0x3FF;
+        if (cell >= model->cellCount()) {
+            clear();
+            return false;
+        }
+        ops.push_back({static_cast<uint16_t>(cell), static_cast<uint16_t>(word >> 10 & 0x1F),
+                       static_cast<uint16_t>(word >> 15)});
+    }
+    cursor = position;
+    return true;
+}
@@ -0,0 +1,55 @@
+#ifndef SUDOKUHISTORY_H
+#define SUDOKUHISTORY_H
+
+#include <cstdint>
+#include <vector>
+#include "sudokuengine.h"
+
+class SudokuModel;
+
+// Undo/redo log of player moves as packed 16-bit ops. An op stores the
+// cell and old XOR new, so applying it again flips the cell back and the
+// same op serves both directions. A move is a run of ops whose first one is
+// flagged, so a single entry costs two bytes and Clear All or an applied
+// hint is one move however many cells it touches. Only moves made through
+// this class are logged; solver replays and model resets are not.
+class SudokuHistory
+{
+public:
+    SudokuHistory();
+
+    void setModel(SudokuModel *model);
+    void clear();
+
+    // Each call is one move; false if nothing changed
+    bool setValue(int cell, int value);
+    bool setValues(const std::vector<SudokuChange> &changes);
+    bool clearEntries();
+
+    bool canUndo() const { return cursor > 0; }
+    bool canRedo() const { return cursor < ops.size(); }
+    bool undo();
+    bool redo();
+
+    // Portable form for saving: cell in bits 0-9, delta in 10-14, move
+    // start in bit 15. restore() rejects logs that don't fit the model.
+    std::vector<uint16_t> packedOps() const;
+    size_t position() const { return cursor; }
+    bool restore(const std::vector<uint16_t> &packed, size_t position);
+
+private:
+    struct Op {
+        uint16_t cell : 10;
+        uint16_t delta : 5;   // old value XOR new value, digits up to 25
+        uint16_t first : 1;   // opens a move
+    };
+    static_assert(sizeof(Op) == 2, "history ops must stay packed");
+
+    SudokuModel *model;
+    std::vector<Op> ops;
+    size_t cursor;   // ops before it are applied, the rest can be redone
+
+    void replay(size_t begin, size_t end);
+};
+
+#endif // SUDOKUHISTORY_H
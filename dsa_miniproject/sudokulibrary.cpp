@@ -0,0 +1,128 @@
+#include "sudokulibrary.h"
+#include <QSaveFile>
+#include <QtEndian>
+#include <QDebug>
+
+namespace {
+
+const quint32 LibraryMagic = 0x42494C53;   // "SLIB" on disk
+const quint16 LibraryVersion = 1;
+
+} // namespace
+
+SudokuLibrary::SudokuLibrary()
+{
+    data = nullptr;
+    for (int d = 0; d < DifficultyCount; ++d)
+        first[d] = counts[d] = 0;
+}
+
+SudokuLibrary::~SudokuLibrary()
+{
+    close();
+}
+
+bool SudokuLibrary::open(const QString &fileName)
+{
+    close();
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    qint64 size = file.size();
+    if (size < HeaderSize) {
+        close();
+        return false;
+    }
+    uchar *mapped = file.map(0, size);
+    if (!mapped) {
+        close();
+        return false;
+    }
+    data = mapped;
+
+    if (qFromLittleEndian<quint32>(data) != LibraryMagic
+        || qFromLittleEndian<quint16>(data + 4) != LibraryVersion) {
+        close();
+        return false;
+    }
+    // Every indexed record has to lie inside the file
+    qint64 records = (size - HeaderSize) / RecordSize;
+    for (int d = 0; d < DifficultyCount; ++d) {
+        first[d] = qFromLittleEndian<quint32>(data + 8 + d * 8);
+        counts[d] = qFromLittleEndian<quint32>(data + 12 + d * 8);
+        if (qint64(first[d]) + counts[d] > records) {
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void SudokuLibrary::close()
+{
+    if (data)
+        file.unmap(const_cast<uchar *>(data));
+    data = nullptr;
+    file.close();
+    for (int d = 0; d < DifficultyCount; ++d)
+        first[d] = counts[d] = 0;
+}
+
+int SudokuLibrary::count(SudokuGenerator::Difficulty difficulty) const
+{
+    return counts[static_cast<int>(difficulty)];
+}
+
+bool SudokuLibrary::puzzle(SudokuGenerator::Difficulty difficulty, int index, SudokuEngine::Grid &givens) const
+{
+    int d = static_cast<int>(difficulty);
+    if (!data || index < 0 || quint32(index) >= counts[d]) return false;
+    unpack(data + HeaderSize + (qint64(first[d]) + index) * RecordSize, givens);
+    return true;
+}
+
+bool SudokuLibrary::write(const QString &fileName, const std::vector<SudokuEngine::Grid> puzzles[DifficultyCount])
+{
+    QByteArray bytes(HeaderSize, 0);
+    uchar *header = reinterpret_cast<uchar *>(bytes.data());
+    qToLittleEndian<quint32>(LibraryMagic, header);
+    qToLittleEndian<quint16>(LibraryVersion, header + 4);
+    quint32 next = 0;
+    for (int d = 0; d < DifficultyCount; ++d) {
+        qToLittleEndian<quint32>(next, header + 8 + d * 8);
+        qToLittleEndian<quint32>(quint32(puzzles[d].size()), header + 12 + d * 8);
+        next += puzzles[d].size();
+    }
+
+    bytes.resize(HeaderSize + qint64(next) * RecordSize);
+    uint8_t *record = reinterpret_cast<uint8_t *>(bytes.data()) + HeaderSize;
+    for (int d = 0; d < DifficultyCount; ++d) {
+        for (const SudokuEngine::Grid &givens : puzzles[d]) {
+            pack(givens, record);
+            record += RecordSize;
+        }
+    }
+
+    QSaveFile out(fileName);
+    if (!out.open(QIODevice::WriteOnly) || out.write(bytes) != bytes.size() || !out.commit()) {
+        qDebug() << "Could not write puzzle library" << fileName;
+        return false;
+    }
+    return true;
+}
+
+void SudokuLibrary::pack(const SudokuEngine::Grid &givens, uint8_t *record)
+{
+    for (int i = 0; i < RecordSize; ++i) {
+        int low = 2 * i + 1 < SudokuEngine::CellCount ? givens[2 * i + 1] : 0;
+        record[i] = uint8_t(givens[2 * i] << 4 | low);
+    }
+}
+
+void SudokuLibrary::unpack(const uint8_t *record, SudokuEngine::Grid &givens)
+{
+    for (int i = 0; i < RecordSize; ++i) {
+        givens[2 * i] = record[i] >> 4;
+        if (2 * i + 1 < SudokuEngine::CellCount)
+            givens[2 * i + 1] = record[i] & 0x0F;
+    }
+}
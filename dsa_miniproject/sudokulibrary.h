@@ -0,0 +1,51 @@
+#ifndef SUDOKULIBRARY_H
+#define SUDOKULIBRARY_H
+
+#include <QFile>
+#include <QString>
+#include <cstdint>
+#include <vector>
+#include "sudokuengine.h"
+#include "sudokugenerator.h"
+
+// Read-only file of 9x9 puzzles, mapped rather than read, so opening it
+// costs the same for ten puzzles or ten million and picking one is an index
+// lookup plus a 41-byte unpack.
+//
+// Layout, little-endian: magic "SLIB", version, a 16-bit pad, then
+// {first, count} per difficulty and the records. A record is the 81 givens
+// at 4 bits each, high nibble first; the last low nibble is 0. Solutions are
+// not stored: every puzzle has exactly one and the engine finds it in
+// microseconds.
+class SudokuLibrary
+{
+public:
+    static constexpr int DifficultyCount = 3;
+    static constexpr int RecordSize = (SudokuEngine::CellCount + 1) / 2;   // 41
+    static constexpr int HeaderSize = 8 + DifficultyCount * 8;
+
+    SudokuLibrary();
+    ~SudokuLibrary();
+
+    // False (and closed) if the file is missing, not a library or truncated
+    bool open(const QString &fileName);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    int count(SudokuGenerator::Difficulty difficulty) const;
+    bool puzzle(SudokuGenerator::Difficulty difficulty, int index, SudokuEngine::Grid &givens) const;
+
+    // puzzles[d] holds the givens for difficulty d
+    static bool write(const QString &fileName, const std::vector<SudokuEngine::Grid> puzzles[DifficultyCount]);
+
+    static void pack(const SudokuEngine::Grid &givens, uint8_t *record);
+    static void unpack(const uint8_t *record, SudokuEngine::Grid &givens);
+
+private:
+    QFile file;
+    const uint8_t *data;   // the mapping, null when closed
+    quint32 first[DifficultyCount];
+    quint32 counts[DifficultyCount];
+};
+
+#endif // SUDOKULIBRARY_H
@@ -0,0 +1,471 @@
+#include "sudokulogic.h"
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+
+namespace {
+
+constexpr uint16_t AllDigits = 0x1FF;
+
+struct Tables {
+    uint8_t row[81];
+    uint8_t col[81];
+    uint8_t box[81];
+    uint8_t units[27][9];    // 9 rows, 9 columns, 9 boxes
+    uint8_t peers[81][20];
+    bool sees[81][81];
+};
+
+constexpr Tables makeTables()
+{
+    Tables t{};
+    for (int i = 0; i < 81; ++i) {
+        int r = i / 9, c = i % 9;
+        t.row[i] = r;
+        t.col[i] = c;
+        t.box[i] = r / 3 * 3 + c / 3;
+    }
+    for (int u = 0; u < 9; ++u) {
+        for (int k = 0; k < 9; ++k) {
+            t.units[u][k] = u * 9 + k;
+            t.units[9 + u][k] = k * 9 + u;
+            t.units[18 + u][k] = (u / 3 * 3 + k / 3) * 9 + u % 3 * 3 + k % 3;
+        }
+    }
+    for (int a = 0; a < 81; ++a) {
+        int n = 0;
+        for (int b = 0; b < 81; ++b) {
+            bool peer = a != b && (t.row[a] == t.row[b] || t.col[a] == t.col[b] || t.box[a] == t.box[b]);
+            t.sees[a][b] = peer;
+            if (peer) t.peers[a][n++] = b;
+        }
+    }
+    return t;
+}
+
+constexpr Tables tables = makeTables();
+
+inline int lowestDigit(uint16_t mask) { return __builtin_ctz(mask) + 1; }
+inline int bitCount(uint16_t mask) { return __builtin_popcount(mask); }
+
+void resetStep(SudokuLogic::Step &step, SudokuLogic::Technique technique)
+{
+    step.technique = technique;
+    step.placements.clear();
+    step.eliminations.clear();
+    step.cells.clear();
+    step.digits = 0;
+    step.unit = -1;
+}
+
+} // namespace
+
+SudokuLogic::SudokuLogic()
+{
+    values.fill(0);
+    cand.fill(0);
+    filled = 0;
+}
+
+bool SudokuLogic::load(const SudokuEngine::Grid &grid)
+{
+    values.fill(0);
+    cand.fill(AllDigits);
+    filled = 0;
+    for (int i = 0; i < SudokuEngine::CellCount; ++i) {
+        int value = grid[i];
+        if (value == 0) continue;
+        if (value > 9 || !(cand[i] & (1u << (value - 1)))) return false;
+        place(i, value);
+    }
+    return true;
+}
+
+void SudokuLogic::place(int cell, int value)
+{
+    uint16_t mask = ~(1u << (value - 1));
+    values[cell] = value;
+    cand[cell] = 0;
+    for (uint8_t peer : tables.peers[cell])
+        cand[peer] &= mask;
+    ++filled;
+}
+
+void SudokuLogic::apply(const Step &step)
+{
+    for (const SudokuEngine::Change &change : step.placements) {
+        if (values[change.cell] == 0)
+            place(change.cell, change.value);
+    }
+    for (const Elimination &elimination : step.eliminations)
+        cand[elimination.cell] &= ~elimination.digits;
+}
+
+bool SudokuLogic::isBroken() const
+{
+    for (int i = 0; i < SudokuEngine::CellCount; ++i) {
+        if (values[i] == 0 && cand[i] == 0) return true;
+    }
+    return false;
+}
+
+bool SudokuLogic::findStep(Step &step) const
+{
+    return findHiddenSingle(step)
+        || findNakedSingle(step)
+        || findLockedCandidates(step)
+        || findNakedSubset(step, 2)
+        || findHiddenSubset(step, 2)
+        || findNakedSubset(step, 3)
+        || findHiddenSubset(step, 3)
+        || findFish(step, 2)
+        || findFish(step, 3)
+        || findXYWing(step)
+        || findXYChain(step);
+}
+
+bool SudokuLogic::findHiddenSingle(Step &step) const
+{
+    for (int u = 0; u < 27; ++u) {
+        uint16_t once = 0, twice = 0;
+        for (uint8_t cell : tables.units[u]) {
+            twice |= once & cand[cell];
+            once |= cand[cell];
+        }
+        uint16_t hidden = once & ~twice;
+        if (!hidden) continue;
+
+        uint16_t bit = hidden & -hidden;
+        for (uint8_t cell : tables.units[u]) {
+            if (cand[cell] & bit) {
+                resetStep(step, Technique::HiddenSingle);
+                step.placements.push_back({cell, static_cast<uint8_t>(lowestDigit(bit))});
+                step.cells.push_back(cell);
+                step.digits = bit;
+                step.unit = u;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool SudokuLogic::findNakedSingle(Step &step) const
+{
+    for (int i = 0; i < SudokuEngine::CellCount; ++i) {
+        uint16_t c = cand[i];
+        if (c && !(c & (c - 1))) {
+            resetStep(step, Technique::NakedSingle);
+            step.placements.push_back({static_cast<uint8_t>(i), static_cast<uint8_t>(lowestDigit(c))});
+            step.cells.push_back(i);
+            step.digits = c;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SudokuLogic::findLockedCandidates(Step &step) const
+{
+    for (int u = 0; u < 27; ++u) {
+        for (uint16_t bit = 1; bit & AllDigits; bit <<= 1) {
+            // Where does this digit still fit inside the unit?
+            int count = 0, first = -1;
+            bool sameRow = true, sameCol = true, sameBox = true;
+            for (uint8_t cell : tables.units[u]) {
+                if (!(cand[cell] & bit)) continue;
+                if (first < 0) {
+                    first = cell;
+                } else {
+                    sameRow &= tables.row[cell] == tables.row[first];
+                    sameCol &= tables.col[cell] == tables.col[first];
+                    sameBox &= tables.box[cell] == tables.box[first];
+                }
+                ++count;
+            }
+            if (count < 2) continue;
+
+            // Pointing: box confined to a line. Claiming: line confined to a box.
+            int target = -1;
+            if (u >= 18) {
+                if (sameRow) target = tables.row[first];
+                else if (sameCol) target = 9 + tables.col[first];
+            } else if (sameBox) {
+                target = 18 + tables.box[first];
+            }
+            if (target < 0) continue;
+
+            resetStep(step, Technique::LockedCandidates);
+            for (uint8_t cell : tables.units[target]) {
+                bool inside = u < 9 ? tables.row[cell] == u
+                            : u < 18 ? tables.col[cell] == u - 9
+                                     : tables.box[cell] == u - 18;
+                if (!inside && (cand[cell] & bit))
+                    step.eliminations.push_back({cell, bit});
+            }
+            if (step.eliminations.empty()) continue;
+            for (uint8_t cell : tables.units[u])
+                if (cand[cell] & bit) step.cells.push_back(cell);
+            step.digits = bit;
+            step.unit = u;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SudokuLogic::findNakedSubset(Step &step, int size) const
+{
+    for (int u = 0; u < 27; ++u) {
+        uint8_t pool[9];
+        int n = 0;
+        for (uint8_t cell : tables.units[u]) {
+            int count = bitCount(cand[cell]);
+            if (count >= 2 && count <= size) pool[n++] = cell;
+        }
+        if (n < size) continue;
+
+        // Every choice of `size` cells from the pool, as a bitmask over it
+        for (int pick = 0; pick < (1 << n); ++pick) {
+            if (bitCount(pick) != size) continue;
+            uint16_t digits = 0;
+            for (int k = 0; k < n; ++k)
+                if (pick & (1 << k)) digits |= cand[pool[k]];
+            if (bitCount(digits) != size) continue;
+
+            resetStep(step, size == 2 ? Technique::NakedPair : Technique::NakedTriple);
+            for (int k = 0; k < n; ++k)
+                if (pick & (1 << k)) step.cells.push_back(pool[k]);
+            for (uint8_t cell : tables.units[u]) {
+                bool member = std::find(step.cells.begin(), step.cells.end(), cell) != step.cells.end();
+                if (!member && (cand[cell] & digits))
+                    step.eliminations.push_back({cell, static_cast<uint16_t>(cand[cell] & digits)});
+            }
+            if (step.eliminations.empty()) continue;
+            step.digits = digits;
+            step.unit = u;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SudokuLogic::findHiddenSubset(Step &step, int size) const
+{
+    for (int u = 0; u < 27; ++u) {
+        // Positions (bit k = k-th cell of the unit) of every digit
+        uint16_t where[9] = {};
+        for (int k = 0; k < 9; ++k) {
+            uint16_t c = cand[tables.units[u][k]];
+            for (int d = 0; d < 9; ++d)
+                if (c & (1u << d)) where[d] |= 1u << k;
+        }
+        int pool[9];
+        int n = 0;
+        for (int d = 0; d < 9; ++d) {
+            int count = bitCount(where[d]);
+            if (count >= 1 && count <= size) pool[n++] = d;
+        }
+        if (n < size) continue;
+
+        for (int pick = 0; pick < (1 << n); ++pick) {
+            if (bitCount(pick) != size) continue;
+            uint16_t positions = 0, digits = 0;
+            for (int k = 0; k < n; ++k) {
+                if (!(pick & (1 << k))) continue;
+                positions |= where[pool[k]];
+                digits |= 1u << pool[k];
+            }
+            if (bitCount(positions) != size) continue;
+
+            resetStep(step, size == 2 ? Technique::HiddenPair : Technique::HiddenTriple);
+            for (int k = 0; k < 9; ++k) {
+                if (!(positions & (1u << k))) continue;
+                uint8_t cell = tables.units[u][k];
+                step.cells.push_back(cell);
+                if (cand[cell] & ~digits)
+                    step.eliminations.push_back({cell, static_cast<uint16_t>(cand[cell] & ~digits)});
+            }
+            if (step.eliminations.empty()) continue;
+            step.digits = digits;
+            step.unit = u;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SudokuLogic::findFish(Step &step, int size) const
+{
+    for (uint16_t bit = 1; bit & AllDigits; bit <<= 1) {
+        for (int byColumn = 0; byColumn < 2; ++byColumn) {
+            // lines[i] = cover positions of the digit in base line i
+            uint16_t lines[9] = {};
+            for (int i = 0; i < 81; ++i) {
+                if (!(cand[i] & bit)) continue;
+                int base = byColumn ? tables.col[i] : tables.row[i];
+                int cover = byColumn ? tables.row[i] : tables.col[i];
+                lines[base] |= 1u << cover;
+            }
+            int pool[9];
+            int n = 0;
+            for (int line = 0; line < 9; ++line) {
+                int count = bitCount(lines[line]);
+                if (count >= 2 && count <= size) pool[n++] = line;
+            }
+            if (n < size) continue;
+
+            for (int pick = 0; pick < (1 << n); ++pick) {
+                if (bitCount(pick) != size) continue;
+                uint16_t covers = 0, bases = 0;
+                for (int k = 0; k < n; ++k) {
+                    if (!(pick & (1 << k))) continue;
+                    covers |= lines[pool[k]];
+                    bases |= 1u << pool[k];
+                }
+                if (bitCount(covers) != size) continue;
+
+                resetStep(step, size == 2 ? Technique::XWing : Technique::Swordfish);
+                for (int i = 0; i < 81; ++i) {
+                    if (!(cand[i] & bit)) continue;
+                    int base = byColumn ? tables.col[i] : tables.row[i];
+                    int cover = byColumn ? tables.row[i] : tables.col[i];
+                    if (!(covers & (1u << cover))) continue;
+                    if (bases & (1u << base))
+                        step.cells.push_back(i);
+                    else
+                        step.eliminations.push_back({static_cast<uint8_t>(i), bit});
+                }
+                if (step.eliminations.empty()) continue;
+                step.digits = bit;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool SudokuLogic::findXYWing(Step &step) const
+{
+    for (int pivot = 0; pivot < 81; ++pivot) {
+        uint16_t p = cand[pivot];
+        if (bitCount(p) != 2) continue;
+
+        for (uint8_t x : tables.peers[pivot]) {
+            uint16_t cx = cand[x];
+            if (bitCount(cx) != 2 || bitCount(cx & p) != 1) continue;
+            uint16_t z = cx & ~p;
+
+            for (uint8_t y : tables.peers[pivot]) {
+                uint16_t cy = cand[y];
+                // Second pincer holds the other pivot digit plus the same z
+                if (y == x || cy != ((p & ~cx) | z)) continue;
+
+                resetStep(step, Technique::XYWing);
+                for (int i = 0; i < 81; ++i) {
+                    if (i != x && i != y && (cand[i] & z) && tables.sees[i][x] && tables.sees[i][y])
+                        step.eliminations.push_back({static_cast<uint8_t>(i), z});
+                }
+                if (step.eliminations.empty()) continue;
+                step.cells = {static_cast<uint8_t>(pivot), x, y};
+                step.digits = p | z;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool SudokuLogic::findXYChain(Step &step) const
+{
+    // Breadth-first over (bivalue cell, digit leaving that cell). A chain that
+    // starts by leaving A with y and ends by leaving B with x proves one of
+    // A, B is x, so x goes from every cell that sees both.
+    constexpr int MaxLength = 16;
+    int parent[81 * 9];
+    uint8_t depth[81 * 9];
+    int queue[81 * 9];
+
+    for (int start = 0; start < 81; ++start) {
+        uint16_t s = cand[start];
+        if (bitCount(s) != 2) continue;
+
+        for (uint16_t x : {static_cast<uint16_t>(s & -s), static_cast<uint16_t>(s & (s - 1))}) {
+            std::fill(std::begin(parent), std::end(parent), -2);
+            int head = 0, tail = 0;
+            int first = start * 9 + lowestDigit(s & ~x) - 1;
+            parent[first] = -1;
+            depth[first] = 1;
+            queue[tail++] = first;
+
+            while (head < tail) {
+                int state = queue[head++];
+                int cell = state / 9;
+                uint16_t out = 1u << (state % 9);
+                if (depth[state] >= MaxLength) continue;
+
+                for (uint8_t next : tables.peers[cell]) {
+                    uint16_t c = cand[next];
+                    if (next == start || bitCount(c) != 2 || !(c & out)) continue;
+                    uint16_t leave = c & ~out;
+                    int nextState = next * 9 + lowestDigit(leave) - 1;
+                    if (parent[nextState] != -2) continue;
+                    parent[nextState] = state;
+                    depth[nextState] = depth[state] + 1;
+                    queue[tail++] = nextState;
+
+                    if (leave != x || depth[nextState] < 3) continue;
+                    resetStep(step, Technique::XYChain);
+                    for (int i = 0; i < 81; ++i) {
+                        if (i != start && i != next && (cand[i] & x) && tables.sees[i][start] && tables.sees[i][next])
+                            step.eliminations.push_back({static_cast<uint8_t>(i), x});
+                    }
+                    if (step.eliminations.empty()) continue;
+                    for (int at = nextState; at >= 0; at = parent[at])
+                        step.cells.insert(step.cells.begin(), static_cast<uint8_t>(at / 9));
+                    step.digits = x;
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+const char *SudokuLogic::techniqueName(Technique technique)
+{
+    switch (technique) {
+    case Technique::HiddenSingle: return "Hidden Single";
+    case Technique::NakedSingle: return "Naked Single";
+    case Technique::LockedCandidates: return "Locked Candidates";
+    case Technique::NakedPair: return "Naked Pair";
+    case Technique::HiddenPair: return "Hidden Pair";
+    case Technique::NakedTriple: return "Naked Triple";
+    case Technique::HiddenTriple: return "Hidden Triple";
+    case Technique::XWing: return "X-Wing";
+    case Technique::Swordfish: return "Swordfish";
+    case Technique::XYWing: return "XY-Wing";
+    case Technique::XYChain: return "XY-Chain";
+    case Technique::Trial: return "Trial and Error";
+    }
+    return "";
+}
+
+int SudokuLogic::techniqueCost(Technique technique)
+{
+    switch (technique) {
+    case Technique::HiddenSingle: return 1;
+    case Technique::NakedSingle: return 2;
+    case Technique::LockedCandidates: return 4;
+    case Technique::NakedPair: return 6;
+    case Technique::HiddenPair: return 8;
+    case Technique::NakedTriple: return 10;
+    case Technique::HiddenTriple: return 12;
+    case Technique::XWing: return 16;
+    case Technique::Swordfish: return 24;
+    case Technique::XYWing: return 28;
+    case Technique::XYChain: return 36;
+    case Technique::Trial: return 100;
+    }
+    return 0;
+}
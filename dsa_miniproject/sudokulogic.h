@@ -0,0 +1,76 @@
+#ifndef SUDOKULOGIC_H
+#define SUDOKULOGIC_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "sudokuengine.h"
+
+// Candidate grid plus the human solving techniques that work on it.
+// findStep() always returns the cheapest deduction available, trying the
+// techniques in the order they are declared in Technique.
+class SudokuLogic
+{
+public:
+    enum class Technique {
+        HiddenSingle,
+        NakedSingle,
+        LockedCandidates,   // pointing and claiming
+        NakedPair,
+        HiddenPair,
+        NakedTriple,
+        HiddenTriple,
+        XWing,
+        Swordfish,
+        XYWing,
+        XYChain,
+        Trial               // nothing above applies, needs guessing
+    };
+
+    struct Elimination {
+        uint8_t cell;
+        uint16_t digits;    // candidate bits removed from the cell
+    };
+
+    struct Step {
+        Technique technique;
+        std::vector<SudokuEngine::Change> placements;
+        std::vector<Elimination> eliminations;
+        std::vector<uint8_t> cells;   // cells forming the pattern
+        uint16_t digits;              // digits the pattern is about
+        int unit;                     // 0-8 rows, 9-17 columns, 18-26 boxes, -1 if none
+    };
+
+    SudokuLogic();
+
+    // Returns false if the givens already conflict
+    bool load(const SudokuEngine::Grid &grid);
+    bool findStep(Step &step) const;
+    void apply(const Step &step);
+
+    bool isSolved() const { return filled == SudokuEngine::CellCount; }
+    bool isBroken() const;   // some empty cell has no candidate left
+    int value(int cell) const { return values[cell]; }
+    uint16_t candidates(int cell) const { return cand[cell]; }
+
+    static const char *techniqueName(Technique technique);
+    static int techniqueCost(Technique technique);
+
+private:
+    SudokuEngine::Grid values;
+    std::array<uint16_t, SudokuEngine::CellCount> cand;
+    int filled;
+
+    void place(int cell, int value);
+
+    bool findHiddenSingle(Step &step) const;
+    bool findNakedSingle(Step &step) const;
+    bool findLockedCandidates(Step &step) const;
+    bool findNakedSubset(Step &step, int size) const;
+    bool findHiddenSubset(Step &step, int size) const;
+    bool findFish(Step &step, int size) const;
+    bool findXYWing(Step &step) const;
+    bool findXYChain(Step &step) const;
+};
+
+#endif // SUDOKULOGIC_H
@@ -0,0 +1,233 @@
+#include "sudokumodel.h"
+
+SudokuModel::SudokuModel(QObject *parent) : QObject(parent)
+{
+    box = 3;
+    filled = 0;
+    conflictCount = 0;
+    batch = nullptr;
+    reset(3, std::vector<uint8_t>(81, 0));
+}
+
+void SudokuModel::reset(int box, const std::vector<uint8_t> &givens)
+{
+    restore(SudokuUnits(box), givens, givens, {});
+}
+
+void SudokuModel::reset(const SudokuUnits &units, const std::vector<uint8_t> &givens)
+{
+    restore(units, givens, givens, {});
+}
+
+void SudokuModel::restore(int box, const std::vector<uint8_t> &givens, const std::vector<uint8_t> &entries,
+                          const std::vector<uint32_t> &notes)
+{
+    restore(SudokuUnits(box), givens, entries, notes);
+}
+
+void SudokuModel::restore(const SudokuUnits &units, const std::vector<uint8_t> &givens,
+                          const std::vector<uint8_t> &entries, const std::vector<uint32_t> &notes)
+{
+    rules = units;
+    box = units.boxSize();
+    int n = size();
+    values.assign(n * n, 0);
+    given.assign(n * n, 0);
+    conflicts.assign(n * n, 0);
+    touched.assign(n * n, 0);
+    unitCounts.assign(rules.unitCount() * n, 0);
+    filled = 0;
+    conflictCount = 0;
+
+    for (int cell = 0; cell < n * n; ++cell) {
+        bool isGiven = givens[cell] >= 1 && givens[cell] <= n;
+        int value = isGiven ? givens[cell] : entries[cell];
+        if (value < 1 || value > n) continue;
+        values[cell] = value;
+        given[cell] = isGiven;
+        ++filled;
+        for (uint16_t unit : rules.unitsOf(cell))
+            ++unitCounts[unit * n + value - 1];
+    }
+    bool keepNotes = static_cast<int>(notes.size()) == n * n;
+    noteMasks.assign(n * n, 0);
+    for (int cell = 0; cell < n * n; ++cell) {
+        conflicts[cell] = computeConflict(cell);
+        conflictCount += conflicts[cell];
+        if (!values[cell])
+            noteMasks[cell] = keepNotes ? notes[cell] & ((1u << n) - 1) : allowedDigits(cell);
+    }
+    emit modelReset();
+}
+
+bool SudokuModel::isSolved() const
+{
+    return filled == cellCount() && conflictCount == 0;
+}
+
+bool SudokuModel::setValue(int cell, int value)
+{
+    int n = size();
+    if (value < 1 || value > n) value = 0;
+    int old = values[cell];
+    if (given[cell] || old == value) return false;
+
+    for (uint16_t unit : rules.unitsOf(cell)) {
+        if (old) --unitCounts[unit * n + old - 1];
+        if (value) ++unitCounts[unit * n + value - 1];
+    }
+    values[cell] = value;
+    filled += (value != 0) - (old != 0);
+    if (batch)
+        touch(cell);
+    else
+        emit cellChanged(cell, value);
+
+    // Only peers holding the old or the new digit can change state
+    recheckPeers(cell, old);
+    recheckPeers(cell, value);
+    recheck(cell);
+    recheckCage(cell);
+    updateNotes(cell, old, value);
+    return true;
+}
+
+uint32_t SudokuModel::allowedDigits(int cell) const
+{
+    uint32_t mask = 0;
+    for (int digit = 1; digit <= size(); ++digit)
+        if (isAllowed(cell, digit)) mask |= 1u << (digit - 1);
+    return mask;
+}
+
+bool SudokuModel::toggleNote(int cell, int digit)
+{
+    if (values[cell] || digit < 1 || digit > size()) return false;
+    std::vector<int> changed;
+    setNotes(cell, noteMasks[cell] ^ (1u << (digit - 1)), changed);
+    if (!batch)
+        emit notesChanged(changed);
+    return true;
+}
+
+bool SudokuModel::isAllowed(int cell, int digit) const
+{
+    int n = size();
+    for (uint16_t unit : rules.unitsOf(cell)) {
+        if (unitCounts[unit * n + digit - 1]) return false;
+    }
+    return true;
+}
+
+void SudokuModel::updateNotes(int cell, int old, int value)
+{
+    std::vector<int> changed;
+    setNotes(cell, value ? 0 : allowedDigits(cell), changed);
+
+    uint32_t oldBit = old ? 1u << (old - 1) : 0;
+    uint32_t newBit = value ? 1u << (value - 1) : 0;
+    for (uint16_t peer : rules.peersOf(cell)) {
+        if (values[peer]) continue;
+        uint32_t mask = noteMasks[peer] & ~newBit;
+        if (oldBit && isAllowed(peer, old))
+            mask |= oldBit;
+        setNotes(peer, mask, changed);
+    }
+    if (!batch && !changed.empty())
+        emit notesChanged(changed);
+}
+
+void SudokuModel::setNotes(int cell, uint32_t mask, std::vector<int> &changed)
+{
+    if (noteMasks[cell] == mask) return;
+    noteMasks[cell] = mask;
+    if (batch)
+        touch(cell);   // repainted with the rest of the batch
+    else
+        changed.push_back(cell);
+}
+
+void SudokuModel::clearEntries()
+{
+    for (int cell = 0; cell < cellCount(); ++cell) {
+        if (!given[cell] && values[cell])
+            setValue(cell, 0);
+    }
+}
+
+bool SudokuModel::computeConflict(int cell) const
+{
+    int value = values[cell];
+    if (value == 0) return false;
+    int n = size();
+    for (uint16_t unit : rules.unitsOf(cell)) {
+        if (unitCounts[unit * n + value - 1] > 1) return true;
+    }
+    int cage = rules.cageOf(cell);
+    return cage >= 0 && cageBroken(cage);
+}
+
+bool SudokuModel::cageBroken(int unit) const
+{
+    // Over the total already, or full and short of it
+    int sum = 0;
+    bool full = true;
+    for (uint16_t cell : rules.cells(unit)) {
+        sum += values[cell];
+        full = full && values[cell];
+    }
+    return sum > rules.sum(unit) || (full && sum != rules.sum(unit));
+}
+
+void SudokuModel::recheck(int cell)
+{
+    bool conflict = computeConflict(cell);
+    if (conflict == static_cast<bool>(conflicts[cell])) return;
+    conflicts[cell] = conflict;
+    conflictCount += conflict ? 1 : -1;
+    if (batch)
+        touch(cell);
+    else
+        emit conflictChanged(cell, conflict);
+}
+
+void SudokuModel::setValues(const std::vector<SudokuChange> &changes)
+{
+    std::vector<int> changed;
+    batch = &changed;
+    for (const SudokuChange &change : changes)
+        setValue(change.cell, change.value);
+    batch = nullptr;
+
+    for (int cell : changed)
+        touched[cell] = 0;
+    if (!changed.empty())
+        emit cellsChanged(changed);
+}
+
+void SudokuModel::touch(int cell)
+{
+    if (touched[cell]) return;
+    touched[cell] = 1;
+    batch->push_back(cell);
+}
+
+void SudokuModel::recheckPeers(int cell, int value)
+{
+    if (!value) return;
+    for (uint16_t peer : rules.peersOf(cell)) {
+        if (values[peer] == value)
+            recheck(peer);
+    }
+}
+
+void SudokuModel::recheckCage(int cell)
+{
+    // Any change to a cage's total can flip every digit in it
+    int cage = rules.cageOf(cell);
+    if (cage < 0) return;
+    for (uint16_t peer : rules.cells(cage)) {
+        if (peer != cell && values[peer])
+            recheck(peer);
+    }
+}
@@ -0,0 +1,97 @@
+#ifndef SUDOKUMODEL_H
+#define SUDOKUMODEL_H
+
+#include <QObject>
+#include <cstdint>
+#include <vector>
+#include "sudokuengine.h"
+#include "sudokuunits.h"
+
+// The game state: one byte per cell in a contiguous row-major array, which
+// cells are givens, per-unit digit counts for conflict tracking and a
+// candidate-note mask per cell (729 bits on 9x9). Units and peers come from
+// the compiled SudokuUnits tables, so variants are checked the same way as
+// the classic board. It is the source of truth for the board widget, the
+// solver and anything that saves or inspects the game; it never touches a
+// widget, so it can run headless.
+class SudokuModel : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SudokuModel(QObject *parent = nullptr);
+
+    // New puzzle; non-zero givens become fixed cells. The box overloads
+    // play the classic rules.
+    void reset(int box, const std::vector<uint8_t> &givens);
+    void reset(const SudokuUnits &units, const std::vector<uint8_t> &givens);
+
+    // Game in progress: givens plus the player's entries and notes, with a
+    // single modelReset. Empty notes are recomputed from the board.
+    void restore(int box, const std::vector<uint8_t> &givens, const std::vector<uint8_t> &entries,
+                 const std::vector<uint32_t> &notes);
+    void restore(const SudokuUnits &units, const std::vector<uint8_t> &givens,
+                 const std::vector<uint8_t> &entries, const std::vector<uint32_t> &notes);
+
+    const SudokuUnits &constraints() const { return rules; }
+    int boxSize() const { return box; }
+    int size() const { return box * box; }
+    int cellCount() const { return static_cast<int>(values.size()); }
+    int index(int row, int col) const { return row * size() + col; }
+
+    const std::vector<uint8_t> &cells() const { return values; }
+    int value(int cell) const { return values[cell]; }
+    int value(int row, int col) const { return values[index(row, col)]; }
+    bool isGiven(int cell) const { return given[cell]; }
+    bool hasConflict(int cell) const { return conflicts[cell]; }
+    bool isSolved() const;   // every cell filled and no conflicts
+
+    // Returns false if the cell is a given or already holds value
+    bool setValue(int cell, int value);
+    void clearEntries();
+
+    // Pencil marks. Placing a digit strikes it from the peers' notes and
+    // clearing one puts it back wherever it is allowed again, touching only
+    // the peers; a cleared cell gets every digit it allows.
+    uint32_t notes(int cell) const { return noteMasks[cell]; }
+    uint32_t allowedDigits(int cell) const;
+    bool toggleNote(int cell, int digit);   // false for filled cells
+
+    // Applies a batch (later entries win) and reports every cell whose
+    // value or conflict state changed in one cellsChanged, instead of a
+    // signal per cell
+    void setValues(const std::vector<SudokuChange> &changes);
+
+signals:
+    void modelReset();
+    void cellChanged(int cell, int value);
+    void conflictChanged(int cell, bool conflict);
+    void cellsChanged(const std::vector<int> &cells);
+    void notesChanged(const std::vector<int> &cells);
+
+private:
+    int box;
+    int filled;
+    int conflictCount;
+    std::vector<uint8_t> values;
+    std::vector<uint8_t> given;
+    std::vector<uint8_t> conflicts;
+    SudokuUnits rules;
+    std::vector<uint16_t> unitCounts;   // [unit * size + digit - 1], units as numbered by rules
+    std::vector<uint32_t> noteMasks;    // bit d - 1 set if d is noted; 0 for filled cells
+    std::vector<int> *batch;            // collects touched cells while setValues runs
+    std::vector<uint8_t> touched;
+
+    void touch(int cell);
+
+    bool computeConflict(int cell) const;
+    bool cageBroken(int unit) const;
+    void recheck(int cell);
+    void recheckPeers(int cell, int value);
+    void recheckCage(int cell);
+    bool isAllowed(int cell, int digit) const;
+    void updateNotes(int cell, int old, int value);
+    void setNotes(int cell, uint32_t mask, std::vector<int> &changed);
+};
+
+#endif // SUDOKUMODEL_H
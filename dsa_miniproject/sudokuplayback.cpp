@@ -0,0 +1,114 @@
+#include "sudokuplayback.h"
+#include <QtMath>
+
+SudokuPlayback::SudokuPlayback(QObject *parent) : QObject(parent)
+{
+    frameTimer = new QTimer(this);
+    frameTimer->setTimerType(Qt::PreciseTimer);
+    frameTimer->setInterval(FrameMs);
+    connect(frameTimer, &QTimer::timeout, this, &SudokuPlayback::onFrame);
+    stepsPerSecond = 20.0;
+    anchorPos = 0;
+    pos = 0;
+}
+
+void SudokuPlayback::setTrace(const std::vector<uint8_t> &start, std::vector<SudokuChange> trace)
+{
+    frameTimer->stop();
+    this->trace = std::move(trace);
+    current = start;
+    shown = start;
+    pos = 0;
+    anchorPos = 0;
+
+    // Checkpoints keep backward scrubbing bounded on very long traces
+    checkpoints.clear();
+    std::vector<uint8_t> grid = start;
+    for (int i = 0; i < length(); ++i) {
+        if (i % CheckpointInterval == 0)
+            checkpoints.push_back(grid);
+        grid[this->trace[i].cell] = this->trace[i].value;
+    }
+}
+
+void SudokuPlayback::setSpeed(double stepsPerSecond)
+{
+    this->stepsPerSecond = qMax(1.0, stepsPerSecond);
+    anchorPos = pos;
+    clock.restart();
+}
+
+void SudokuPlayback::play()
+{
+    if (pos >= length()) {
+        present();
+        emit finished();
+        return;
+    }
+    anchorPos = pos;
+    clock.start();
+    frameTimer->start();
+}
+
+void SudokuPlayback::pause()
+{
+    frameTimer->stop();
+}
+
+void SudokuPlayback::seek(int position)
+{
+    moveTo(qBound(0, position, length()));
+    anchorPos = pos;
+    clock.restart();
+    present();
+}
+
+void SudokuPlayback::skipToEnd()
+{
+    frameTimer->stop();
+    moveTo(length());
+    present();
+    emit finished();
+}
+
+bool SudokuPlayback::isPlaying() const
+{
+    return frameTimer->isActive();
+}
+
+void SudokuPlayback::onFrame()
+{
+    qint64 due = anchorPos + qFloor(clock.elapsed() * stepsPerSecond / 1000.0);
+    moveTo(static_cast<int>(qMin<qint64>(due, length())));
+    present();
+    if (pos >= length()) {
+        frameTimer->stop();
+        emit finished();
+    }
+}
+
+void SudokuPlayback::moveTo(int target)
+{
+    if (target < pos) {
+        // Rewind to the nearest checkpoint, then replay forwards
+        int index = target / CheckpointInterval;
+        current = checkpoints[index];
+        pos = index * CheckpointInterval;
+    }
+    for (; pos < target; ++pos)
+        current[trace[pos].cell] = trace[pos].value;
+}
+
+void SudokuPlayback::present()
+{
+    delta.clear();
+    for (int i = 0; i < static_cast<int>(current.size()); ++i) {
+        if (shown[i] != current[i]) {
+            shown[i] = current[i];
+            delta.push_back({static_cast<uint16_t>(i), current[i]});
+        }
+    }
+    if (!delta.empty())
+        emit cellsUpdated(delta);
+    emit frameFinished(pos);
+}
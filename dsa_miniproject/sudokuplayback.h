@@ -0,0 +1,64 @@
+#ifndef SUDOKUPLAYBACK_H
+#define SUDOKUPLAYBACK_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <vector>
+#include "sudokuengine.h"
+
+// Replays a trace recorded by SudokuEngine at a chosen speed, on any board
+// size (the size follows from the start grid).
+// Playback position is derived from wall-clock time, not from the number of
+// timer ticks, so the speed is independent of the frame rate. Every frame
+// collapses all the steps it covers and reports, in one batch, only the
+// cells whose value differs from what was shown in the previous frame.
+class SudokuPlayback : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SudokuPlayback(QObject *parent = nullptr);
+
+    void setTrace(const std::vector<uint8_t> &start, std::vector<SudokuChange> trace);
+    void setSpeed(double stepsPerSecond);
+    double speed() const { return stepsPerSecond; }
+
+    void play();
+    void pause();
+    void seek(int position);   // scrub forwards or backwards
+    void skipToEnd();
+
+    bool isPlaying() const;
+    int position() const { return pos; }
+    int length() const { return static_cast<int>(trace.size()); }
+
+signals:
+    void cellsUpdated(const std::vector<SudokuChange> &changes); // one entry per cell at most
+    void frameFinished(int position);
+    void finished();
+
+private slots:
+    void onFrame();
+
+private:
+    static constexpr int FrameMs = 16;
+    static constexpr int CheckpointInterval = 1024;
+
+    QTimer *frameTimer;
+    QElapsedTimer clock;
+    double stepsPerSecond;
+    int anchorPos;          // position when the clock was last restarted
+
+    std::vector<SudokuChange> trace;
+    std::vector<std::vector<uint8_t>> checkpoints;   // grid before every CheckpointInterval-th step
+    std::vector<uint8_t> current;   // grid after the first pos steps
+    std::vector<uint8_t> shown;     // grid last reported through cellsUpdated
+    std::vector<SudokuChange> delta;   // reused between frames
+    int pos;
+
+    void moveTo(int target);
+    void present();
+};
+
+#endif // SUDOKUPLAYBACK_H
@@ -0,0 +1,186 @@
+#include "sudokupuzzlepool.h"
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+#include <QRandomGenerator>
+#include <QDebug>
+#include <utility>
+
+namespace {
+
+const quint32 PoolMagic = 0x53504F4C;   // "SPOL"
+const quint16 PoolVersion = 2;
+
+} // namespace
+
+SudokuPuzzlePool::SudokuPuzzlePool(const QString &fileName, QObject *parent)
+    : QObject(parent)
+    , fileName(fileName)
+    , level(8)
+    , requested(-1)
+    , stopping(false)
+{
+    load();
+    worker = QThread::create([this]() { refillLoop(); });
+    worker->start(QThread::LowestPriority);
+}
+
+SudokuPuzzlePool::~SudokuPuzzlePool()
+{
+    stopping = true;
+    {
+        QMutexLocker locker(&mutex);
+        wake.wakeAll();
+    }
+    worker->wait();
+    delete worker;
+    save();
+}
+
+void SudokuPuzzlePool::setWatermark(int count)
+{
+    QMutexLocker locker(&mutex);
+    level = qMax(1, count);
+    wake.wakeAll();
+}
+
+int SudokuPuzzlePool::watermark() const
+{
+    QMutexLocker locker(&mutex);
+    return level;
+}
+
+int SudokuPuzzlePool::available(SudokuGenerator::Difficulty difficulty) const
+{
+    QMutexLocker locker(&mutex);
+    return stock[static_cast<int>(difficulty)].size();
+}
+
+bool SudokuPuzzlePool::pop(SudokuGenerator::Difficulty difficulty, SudokuGenerator::Puzzle &puzzle)
+{
+    QMutexLocker locker(&mutex);
+    QQueue<SudokuGenerator::Puzzle> &queue = stock[static_cast<int>(difficulty)];
+    if (queue.isEmpty()) return false;
+    puzzle = queue.dequeue();
+    wake.wakeAll();
+    return true;
+}
+
+void SudokuPuzzlePool::request(SudokuGenerator::Difficulty difficulty)
+{
+    QMutexLocker locker(&mutex);
+    int d = static_cast<int>(difficulty);
+    if (!stock[d].isEmpty()) return;
+    requested = d;
+    wake.wakeAll();
+}
+
+void SudokuPuzzlePool::refillLoop()
+{
+    bool dirty = false;
+    while (!stopping) {
+        int neediest = -1;
+        {
+            QMutexLocker locker(&mutex);
+            int lowest = level;
+            for (int d = 0; d < DifficultyCount; ++d) {
+                if (stock[d].size() < lowest) {
+                    lowest = stock[d].size();
+                    neediest = d;
+                }
+            }
+            // Someone is waiting on an empty stock: that comes first
+            if (requested != -1 && stock[requested].isEmpty())
+                neediest = requested;
+            if (neediest == -1) {
+                // Everything is at the watermark: persist once, then sleep until a pop
+                if (dirty) {
+                    locker.unlock();
+                    save();
+                    dirty = false;
+                    continue;
+                }
+                if (!stopping)
+                    wake.wait(&mutex);
+                continue;
+            }
+        }
+
+        SudokuGenerator::Puzzle puzzle = SudokuGenerator::generate(
+            QRandomGenerator::global()->generate64(),
+            static_cast<SudokuGenerator::Difficulty>(neediest));
+
+        QMutexLocker locker(&mutex);
+        bool wasEmpty = stock[neediest].isEmpty();
+        stock[neediest].enqueue(puzzle);
+        dirty = true;
+        if (requested == neediest)
+            requested = -1;
+        if (wasEmpty) {
+            locker.unlock();
+            emit puzzleReady();
+        }
+    }
+}
+
+void SudokuPuzzlePool::load()
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) return;
+
+    QDataStream in(&file);
+    quint32 magic;
+    quint16 version;
+    in >> magic >> version;
+    if (magic != PoolMagic || version != PoolVersion) return;
+
+    for (int d = 0; d < DifficultyCount; ++d) {
+        quint32 count;
+        in >> count;
+        for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+            SudokuGenerator::Puzzle puzzle;
+            quint64 seed;
+            quint16 score;
+            quint8 hardest;
+            in >> seed >> score >> hardest;
+            in.readRawData(reinterpret_cast<char *>(puzzle.givens.data()), SudokuEngine::CellCount);
+            in.readRawData(reinterpret_cast<char *>(puzzle.solution.data()), SudokuEngine::CellCount);
+            puzzle.seed = seed;
+            puzzle.score = score;
+            puzzle.hardest = static_cast<SudokuLogic::Technique>(hardest);
+            puzzle.difficulty = static_cast<SudokuGenerator::Difficulty>(d);
+            puzzle.clues = 0;
+            for (uint8_t value : puzzle.givens)
+                if (value) ++puzzle.clues;
+            if (in.status() == QDataStream::Ok)
+                stock[d].enqueue(puzzle);
+        }
+    }
+}
+
+void SudokuPuzzlePool::save() const
+{
+    // Snapshot under the lock, write without it
+    QQueue<SudokuGenerator::Puzzle> snapshot[DifficultyCount];
+    {
+        QMutexLocker locker(&mutex);
+        for (int d = 0; d < DifficultyCount; ++d)
+            snapshot[d] = stock[d];
+    }
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) return;
+
+    QDataStream out(&file);
+    out << PoolMagic << PoolVersion;
+    for (int d = 0; d < DifficultyCount; ++d) {
+        out << quint32(snapshot[d].size());
+        for (const SudokuGenerator::Puzzle &puzzle : std::as_const(snapshot[d])) {
+            out << quint64(puzzle.seed) << quint16(puzzle.score) << quint8(puzzle.hardest);
+            out.writeRawData(reinterpret_cast<const char *>(puzzle.givens.data()), SudokuEngine::CellCount);
+            out.writeRawData(reinterpret_cast<const char *>(puzzle.solution.data()), SudokuEngine::CellCount);
+        }
+    }
+    if (!file.commit())
+        qDebug() << "Could not save puzzle pool to" << fileName;
+}
@@ -0,0 +1,57 @@
+#ifndef SUDOKUPUZZLEPOOL_H
+#define SUDOKUPUZZLEPOOL_H
+
+#include <QObject>
+#include <QQueue>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThread>
+#include <atomic>
+#include "sudokugenerator.h"
+
+// Per-difficulty stock of ready puzzles.
+// A low-priority worker keeps every difficulty topped up to the watermark,
+// so taking a puzzle is just a queue pop. The stock is written to disk when
+// the worker goes idle and on destruction, and read back on construction.
+// When a stock runs dry the caller asks for that difficulty with request()
+// and waits for puzzleReady() instead of generating on its own thread.
+class SudokuPuzzlePool : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SudokuPuzzlePool(const QString &fileName = "sudoku_pool.dat", QObject *parent = nullptr);
+    ~SudokuPuzzlePool();
+
+    void setWatermark(int count);
+    int watermark() const;
+    int available(SudokuGenerator::Difficulty difficulty) const;
+
+    // Never waits for generation; returns false only when that stock is empty
+    bool pop(SudokuGenerator::Difficulty difficulty, SudokuGenerator::Puzzle &puzzle);
+
+    // Makes that difficulty the worker's next puzzle if its stock is empty
+    void request(SudokuGenerator::Difficulty difficulty);
+
+signals:
+    // Emitted from the worker thread when an empty stock gets a puzzle
+    void puzzleReady();
+
+private:
+    static constexpr int DifficultyCount = 3;
+
+    QString fileName;
+    mutable QMutex mutex;
+    QWaitCondition wake;
+    QQueue<SudokuGenerator::Puzzle> stock[DifficultyCount];
+    int level;
+    int requested;   // difficulty someone is waiting on, -1 for none
+    std::atomic<bool> stopping;
+    QThread *worker;
+
+    void refillLoop();
+    void load();
+    void save() const;
+};
+
+#endif // SUDOKUPUZZLEPOOL_H
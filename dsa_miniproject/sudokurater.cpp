@@ -0,0 +1,33 @@
+#include "sudokurater.h"
+
+SudokuRater::Rating SudokuRater::rate(const SudokuEngine::Grid &givens)
+{
+    Rating rating;
+    rating.solved = false;
+    rating.score = 0;
+    rating.steps = 0;
+    rating.hardest = SudokuLogic::Technique::HiddenSingle;
+
+    SudokuLogic logic;
+    if (!logic.load(givens)) {
+        rating.hardest = SudokuLogic::Technique::Trial;
+        return rating;
+    }
+
+    // One Step reused for the whole solve, so its vectors only grow once
+    SudokuLogic::Step step;
+    while (!logic.isSolved()) {
+        if (logic.isBroken() || !logic.findStep(step)) {
+            rating.hardest = SudokuLogic::Technique::Trial;
+            rating.score += SudokuLogic::techniqueCost(SudokuLogic::Technique::Trial);
+            return rating;
+        }
+        logic.apply(step);
+        rating.score += SudokuLogic::techniqueCost(step.technique);
+        ++rating.steps;
+        if (step.technique > rating.hardest)
+            rating.hardest = step.technique;
+    }
+    rating.solved = true;
+    return rating;
+}
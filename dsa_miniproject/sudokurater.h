@@ -0,0 +1,23 @@
+#ifndef SUDOKURATER_H
+#define SUDOKURATER_H
+
+#include "sudokuengine.h"
+#include "sudokulogic.h"
+
+// Grades a puzzle the way a person would experience it: solve it with
+// SudokuLogic, always taking the cheapest deduction, and add up the cost
+// of every step. A puzzle that runs out of techniques is rated Trial.
+class SudokuRater
+{
+public:
+    struct Rating {
+        bool solved;                        // false if techniques ran out or the givens are broken
+        int score;                          // sum of technique costs over all steps
+        int steps;
+        SudokuLogic::Technique hardest;
+    };
+
+    static Rating rate(const SudokuEngine::Grid &givens);
+};
+
+#endif // SUDOKURATER_H
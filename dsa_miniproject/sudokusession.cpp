@@ -0,0 +1,111 @@
+#include "sudokusession.h"
+#include <QDataStream>
+#include <QFile>
+#include <QSaveFile>
+#include <QDebug>
+
+namespace {
+
+const quint32 SessionMagic = 0x53534553;   // "SSES"
+const quint16 SessionVersion = 1;
+
+// Notes are stored in as few bytes as the digit count needs
+int noteBytes(int size)
+{
+    return (size + 7) / 8;
+}
+
+} // namespace
+
+SudokuSession::SudokuSession(const QString &fileName)
+    : fileName(fileName)
+{
+    writer.setMaxThreadCount(1);
+}
+
+SudokuSession::~SudokuSession()
+{
+    writer.waitForDone();
+}
+
+void SudokuSession::save(const Snapshot &snapshot)
+{
+    QString target = fileName;
+    writer.start([target, snapshot]() {
+        if (!write(target, snapshot))
+            qDebug() << "Could not save Sudoku session to" << target;
+    });
+}
+
+void SudokuSession::discard()
+{
+    QString target = fileName;
+    writer.start([target]() { QFile::remove(target); });
+}
+
+bool SudokuSession::write(const QString &fileName, const Snapshot &snapshot)
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+
+    int size = snapshot.box * snapshot.box;
+    int cells = size * size;
+    QDataStream out(&file);
+    out << SessionMagic << SessionVersion;
+    out << quint8(snapshot.box) << snapshot.difficulty << snapshot.rules << quint64(snapshot.seed)
+        << quint8(snapshot.fromLibrary) << qint64(snapshot.elapsedMs);
+    out.writeRawData(reinterpret_cast<const char *>(snapshot.givens.data()), cells);
+    out.writeRawData(reinterpret_cast<const char *>(snapshot.entries.data()), cells);
+    for (uint32_t mask : snapshot.notes) {
+        for (int b = 0; b < noteBytes(size); ++b)
+            out << quint8(mask >> (8 * b));
+    }
+    out << quint32(snapshot.history.size()) << snapshot.historyPosition;
+    for (uint16_t op : snapshot.history)
+        out << quint16(op);
+    return out.status() == QDataStream::Ok && file.commit();
+}
+
+bool SudokuSession::load(Snapshot &snapshot) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    QDataStream in(&file);
+    quint32 magic;
+    quint16 version;
+    in >> magic >> version;
+    if (magic != SessionMagic || version != SessionVersion) return false;
+
+    quint8 box, fromLibrary;
+    in >> box >> snapshot.difficulty >> snapshot.rules >> snapshot.seed >> fromLibrary >> snapshot.elapsedMs;
+    snapshot.fromLibrary = fromLibrary != 0;
+    if (box < 3 || box > 5) return false;
+    snapshot.box = box;
+    int size = box * box;
+    int cells = size * size;
+
+    snapshot.givens.resize(cells);
+    snapshot.entries.resize(cells);
+    in.readRawData(reinterpret_cast<char *>(snapshot.givens.data()), cells);
+    in.readRawData(reinterpret_cast<char *>(snapshot.entries.data()), cells);
+    snapshot.notes.assign(cells, 0);
+    for (uint32_t &mask : snapshot.notes) {
+        for (int b = 0; b < noteBytes(size); ++b) {
+            quint8 byte;
+            in >> byte;
+            mask |= uint32_t(byte) << (8 * b);
+        }
+    }
+
+    quint32 count;
+    in >> count >> snapshot.historyPosition;
+    if (in.status() != QDataStream::Ok || count > file.size()) return false;
+    snapshot.history.resize(count);
+    for (uint16_t &op : snapshot.history) {
+        quint16 word;
+        in >> word;
+        op = word;
+    }
+    return in.status() == QDataStream::Ok;
+}
@@ -0,0 +1,44 @@
+#ifndef SUDOKUSESSION_H
+#define SUDOKUSESSION_H
+
+#include <QString>
+#include <QThreadPool>
+#include <cstdint>
+#include <vector>
+
+// The game in progress on disk, so leaving the screen or quitting does not
+// lose it. One small versioned binary file; writes go through QSaveFile on
+// a single background thread, so they are atomic and land in call order.
+// Loading is a synchronous read of a few hundred bytes.
+class SudokuSession
+{
+public:
+    struct Snapshot {
+        int box;
+        QString difficulty;
+        QString rules;                  // SudokuVariants::rulesText, "classic" for the ordinary game
+        quint64 seed;                   // generator seed, or library index
+        bool fromLibrary;               // which of the two seed holds
+        qint64 elapsedMs;
+        std::vector<uint8_t> givens;    // 0 for player cells
+        std::vector<uint8_t> entries;   // player values, 0 for empty and given cells
+        std::vector<uint32_t> notes;    // candidate-note mask per cell
+        std::vector<uint16_t> history;  // packed SudokuHistory ops
+        quint32 historyPosition;
+    };
+
+    explicit SudokuSession(const QString &fileName = "sudoku_session.dat");
+    ~SudokuSession();   // waits for pending writes
+
+    void save(const Snapshot &snapshot);
+    void discard();
+    bool load(Snapshot &snapshot) const;
+
+private:
+    QString fileName;
+    QThreadPool writer;
+
+    static bool write(const QString &fileName, const Snapshot &snapshot);
+};
+
+#endif // SUDOKUSESSION_H
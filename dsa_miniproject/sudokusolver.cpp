@@ -1,38 +1,120 @@
 #include "sudokusolver.h"
+#include "sudokuplayback.h"
+#include "sudokudlx.h"
+#include "sudokuvariantengine.h"
+#include "sudokumodel.h"
+#include <QtConcurrent>
 #include <QDebug>
+#include <algorithm>
+
+namespace {
+
+// One instantiation per box size; grid holds the givens on entry and the
+// result on return. Fills the counters and phase times of stats.
+template <int Box>
+bool solveGrid(std::vector<uint8_t> &grid, bool dancingLinks, std::vector<SudokuChange> *trace,
+               SudokuSolver::Stats &stats)
+{
+    typename BasicSudokuEngine<Box>::Grid givens;
+    std::copy(grid.begin(), grid.end(), givens.begin());
+    typename BasicSudokuEngine<Box>::Stats counters;
+    QElapsedTimer clock;
+    clock.start();
+    bool solved;
+    if (dancingLinks) {
+        BasicSudokuDlx<Box> worker;
+        typename BasicSudokuEngine<Box>::Grid solution = givens;
+        worker.load(givens);
+        stats.setupUs = clock.nsecsElapsed() / 1000;
+        clock.restart();
+        solved = worker.solve(solution, trace);
+        counters = worker.stats();
+        std::copy(solution.begin(), solution.end(), grid.begin());
+    } else {
+        BasicSudokuEngine<Box> worker;
+        worker.load(givens);
+        stats.setupUs = clock.nsecsElapsed() / 1000;
+        clock.restart();
+        auto status = trace ? worker.solve(*trace) : worker.solve();
+        solved = status == BasicSudokuEngine<Box>::Status::Solved;
+        counters = worker.stats();
+        std::copy(worker.grid().begin(), worker.grid().end(), grid.begin());
+    }
+    stats.searchUs = clock.nsecsElapsed() / 1000;
+    stats.solved = solved;
+    stats.nodes = counters.nodes;
+    stats.backtracks = counters.backtracks;
+    stats.rounds = counters.rounds;
+    stats.maxDepth = counters.maxDepth;
+    return solved;
+}
+
+// Diagonals, jigsaw regions and cages are beyond the fixed-layout backends
+bool solveVariant(std::vector<uint8_t> &grid, const SudokuUnits &rules, std::vector<SudokuChange> *trace,
+                  SudokuSolver::Stats &stats)
+{
+    QElapsedTimer clock;
+    clock.start();
+    SudokuVariantEngine worker;
+    worker.load(rules, grid);
+    stats.setupUs = clock.nsecsElapsed() / 1000;
+    clock.restart();
+    bool solved = (trace ? worker.solve(*trace) : worker.solve()) == SudokuVariantEngine::Status::Solved;
+    stats.searchUs = clock.nsecsElapsed() / 1000;
+    if (solved)
+        grid = worker.grid();
+    stats.solved = solved;
+    stats.nodes = worker.stats().nodes;
+    stats.backtracks = worker.stats().backtracks;
+    stats.rounds = worker.stats().rounds;
+    stats.maxDepth = worker.stats().maxDepth;
+    return solved;
+}
+
+} // namespace
 
 SudokuSolver::SudokuSolver(QObject *parent) : QObject(parent)
 {
-    stepTimer = new QTimer(this);
-    connect(stepTimer, &QTimer::timeout, this, &SudokuSolver::performStep);
+    watcher = new QFutureWatcher<SolveResult>(this);
+    connect(watcher, &QFutureWatcher<SolveResult>::finished, this, &SudokuSolver::onWorkerFinished);
+    player = new SudokuPlayback(this);
+    connect(player, &SudokuPlayback::cellsUpdated, this, &SudokuSolver::cellsUpdated);
+    connect(player, &SudokuPlayback::finished, this, &SudokuSolver::onPlaybackFinished);
+    backend = Backend::Propagation;
+    boxSize = 3;
     solving = false;
+    animated = false;
+    solved = false;
     delay = 50;
+    stats = {};
 }
 
-void SudokuSolver::setBoard(const QVector<QVector<int>> &board)
+void SudokuSolver::setBoard(const SudokuModel &model)
 {
-    this->board = board;
+    board = model.cells();
+    boxSize = model.boxSize();
+    rules = model.constraints();
 }
 
 void SudokuSolver::startSolving(int delayMs)
 {
     if (solving) return;
     delay = delayMs;
-    solving = true;
-    backtracking = false;
-    stack.clear();
-    currentRow = 0;
-    currentCol = 0;
-    nextNum = 1;
-    elapsedTimer.start();
-    startIterativeSolver();
-    stepTimer->start(delay);
+    animated = true;
+    run(true);
+}
+
+void SudokuSolver::solveInstantly()
+{
+    if (solving) return;
+    animated = false;
+    run(false);
 }
 
 void SudokuSolver::stopSolving()
 {
     if (solving) {
-        stepTimer->stop();
+        player->pause();
         solving = false;
     }
 }
@@ -42,110 +124,71 @@ bool SudokuSolver::isSolving() const
     return solving;
 }
 
-void SudokuSolver::performStep()
-{
-    if (!solving) return;
-
-    // Find next empty cell
-    if (!findNextEmpty(currentRow, currentCol)) {
-        // No empty cells – puzzle solved
-        stepTimer->stop();
-        solving = false;
-        emit solvingFinished(true, elapsedTimer.elapsed());
-        return;
-    }
-
-    // Try numbers from nextNum (or 1 if we are at a new cell)
-    if (!backtracking) {
-        nextNum = 1;
-    }
-
-    bool placed = false;
-    for (int num = nextNum; num <= 9; ++num) {
-        if (isValid(currentRow, currentCol, num)) {
-            // Place the number
-            board[currentRow][currentCol] = num;
-            emit cellUpdated(currentRow, currentCol, num);
-            // Push step onto stack
-            Step step;
-            step.row = currentRow;
-            step.col = currentCol;
-            step.currentNum = num;
-            step.forward = true;
-            stack.push_back(step);
-            // Move to next cell
-            backtracking = false;
-            placed = true;
-            break;
-        }
-    }
-
-    if (!placed) {
-        // No valid number – need to backtrack
-        if (stack.isEmpty()) {
-            // No solution
-            stepTimer->stop();
-            solving = false;
-            emit solvingFinished(false, elapsedTimer.elapsed());
-            return;
-        }
-
-        // Backtrack: pop last step, clear that cell, and set nextNum to that number+1
-        Step last = stack.back();
-        stack.pop_back();
-        board[last.row][last.col] = 0;
-        emit cellUpdated(last.row, last.col, 0);
-        currentRow = last.row;
-        currentCol = last.col;
-        nextNum = last.currentNum + 1;
-        backtracking = true;
-    } else {
-        // Successfully placed, next step will find next empty cell
-        backtracking = false;
-    }
-}
-
-bool SudokuSolver::findNextEmpty(int &row, int &col)
+void SudokuSolver::run(bool record)
 {
-    for (int r = 0; r < 9; ++r) {
-        for (int c = 0; c < 9; ++c) {
-            if (board[r][c] == 0) {
-                row = r;
-                col = c;
-                return true;
+    solving = true;
+    elapsedTimer.start();
+    std::vector<uint8_t> grid = board;
+    bool dancingLinks = backend == Backend::DancingLinks;
+    int box = boxSize;
+    Backend used = backend;
+    SudokuUnits units = rules;
+    watcher->setFuture(QtConcurrent::run([grid, record, dancingLinks, box, used, units]() {
+        QElapsedTimer clock;
+        clock.start();
+        SolveResult result;
+        result.grid = grid;
+        result.stats = {};
+        result.stats.backend = used;
+        result.stats.boxSize = box;
+        result.stats.variant = !units.isClassic();
+        std::vector<SudokuChange> *trace = record ? &result.trace : nullptr;
+        if (result.stats.variant) {
+            result.solved = solveVariant(result.grid, units, trace, result.stats);
+        } else {
+            switch (box) {
+            case 4: result.solved = solveGrid<4>(result.grid, dancingLinks, trace, result.stats); break;
+            case 5: result.solved = solveGrid<5>(result.grid, dancingLinks, trace, result.stats); break;
+            default: result.solved = solveGrid<3>(result.grid, dancingLinks, trace, result.stats); break;
             }
         }
-    }
-    return false;
+        result.elapsedUs = clock.nsecsElapsed() / 1000;
+        result.stats.traceLength = static_cast<int>(result.trace.size());
+        return result;
+    }));
 }
 
-bool SudokuSolver::isValid(int row, int col, int num)
+void SudokuSolver::onWorkerFinished()
 {
-    // Check row
-    for (int c = 0; c < 9; ++c) {
-        if (board[row][c] == num) return false;
-    }
-    // Check column
-    for (int r = 0; r < 9; ++r) {
-        if (board[r][col] == num) return false;
-    }
-    // Check 3x3 box
-    int boxRow = row / 3 * 3;
-    int boxCol = col / 3 * 3;
-    for (int r = 0; r < 3; ++r) {
-        for (int c = 0; c < 3; ++c) {
-            if (board[boxRow + r][boxCol + c] == num) return false;
-        }
+    // Stopped (or superseded by another solve) while the worker was running
+    if (!solving) return;
+
+    SolveResult result = watcher->result();
+    solved = result.solved;
+    stats = result.stats;
+    emit statsUpdated(stats);
+
+    if (animated) {
+        // Search is done; now show it at the requested pace
+        player->setTrace(board, std::move(result.trace));
+        player->setSpeed(1000.0 / qMax(1, delay));
+        emit traceReady(player->length());
+        replayTimer.start();
+        player->play();
+        return;
     }
-    return true;
+
+    solving = false;
+    if (solved)
+        emit solutionReady(result.grid);
+    emit solvingFinished(solved, result.elapsedUs);
 }
 
-void SudokuSolver::startIterativeSolver()
+void SudokuSolver::onPlaybackFinished()
 {
-    // Initialize by finding first empty cell
-    if (!findNextEmpty(currentRow, currentCol)) {
-        // Already solved
-        emit solvingFinished(true, 0);
-        solving = false;
-    }
+    if (!solving) return;
+    solving = false;
+    stats.replayUs = replayTimer.nsecsElapsed() / 1000;
+    emit statsUpdated(stats);
+    emit solvingFinished(solved, elapsedTimer.nsecsElapsed() / 1000);
 }
@@ -3,47 +3,84 @@
 
 #include <QObject>
 #include <QVector>
-#include <QTimer>
 #include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <vector>
+#include "sudokuengine.h"
+#include "sudokuunits.h"
+
+class SudokuPlayback;
+class SudokuModel;
 
 class SudokuSolver : public QObject
 {
     Q_OBJECT
 
 public:
+    enum class Backend { Propagation, DancingLinks };
+
+    // Cost of the last solve, split by phase, for the stats overlay
+    struct Stats {
+        Backend backend;
+        bool variant;          // non-classic rules, which always use SudokuVariantEngine
+        int boxSize;
+        bool solved;
+        uint64_t nodes;        // guesses tried
+        uint64_t backtracks;   // guesses undone
+        uint64_t rounds;       // propagation passes, 0 for Dancing Links
+        uint32_t maxDepth;     // most guesses open at once
+        qint64 setupUs;        // engine load or exact-cover matrix build
+        qint64 searchUs;
+        qint64 replayUs;       // animated playback, 0 in instant mode
+        int traceLength;       // recorded steps, 0 in instant mode
+    };
+
     explicit SudokuSolver(QObject *parent = nullptr);
-    void setBoard(const QVector<QVector<int>> &board);
-    void startSolving(int delayMs = 50); // delay between steps
+    void setBackend(Backend backend) { this->backend = backend; }
+    Backend currentBackend() const { return backend; }
+    void setBoard(const SudokuModel &model);   // copies the current cells and rules
+    void startSolving(int delayMs = 50); // records the search, then replays it with delayMs per step
+    void solveInstantly();               // full speed on a worker thread, result arrives in one batch
     void stopSolving();
     bool isSolving() const;
+    SudokuPlayback *playback() const { return player; }
+    const Stats &lastStats() const { return stats; }
 
 signals:
-    void cellUpdated(int row, int col, int value); // value 0 means clear
-    void solvingFinished(bool solved, int timeMs);
+    void cellsUpdated(const std::vector<SudokuChange> &changes); // one replay frame
+    void solutionReady(const std::vector<uint8_t> &solution); // instant mode only, row-major
+    void traceReady(int length);                   // animated mode, before playback starts
+    void solvingFinished(bool solved, qint64 elapsedUs);
+    void statsUpdated(const SudokuSolver::Stats &stats);   // after the search, and again after a replay
 
 private slots:
-    void performStep();
+    void onWorkerFinished();
+    void onPlaybackFinished();
 
 private:
-    QVector<QVector<int>> board;
-    QTimer *stepTimer;
+    struct SolveResult {
+        bool solved;
+        std::vector<uint8_t> grid;
+        qint64 elapsedUs;   // pure compute time on the worker
+        std::vector<SudokuChange> trace;
+        Stats stats;
+    };
+
+    std::vector<uint8_t> board;   // row-major, 9x9, 16x16 or 25x25
+    int boxSize;
+    SudokuUnits rules;
+    QFutureWatcher<SolveResult> *watcher;
+    SudokuPlayback *player;
+    Backend backend;
     QElapsedTimer elapsedTimer;
+    QElapsedTimer replayTimer;
+    Stats stats;
     bool solving;
+    bool animated;
+    bool solved;
     int delay;
 
-    struct Step {
-        int row, col;
-        int currentNum;   // the number we are trying (0 means not tried yet)
-        bool forward;     // true if we are moving forward, false when backtracking
-    };
-    QVector<Step> stack;
-    int currentRow, currentCol;
-    int nextNum;
-    bool backtracking;
-
-    bool findNextEmpty(int &row, int &col);
-    bool isValid(int row, int col, int num);
-    void startIterativeSolver();
+    void run(bool record);
 };
 
 #endif // SUDOKUSOLVER_H
@@ -0,0 +1,130 @@
+#include "sudokuunits.h"
+
+SudokuUnits::SudokuUnits(int box)
+{
+    this->box = box;
+    diagonals = false;
+    jigsaw = false;
+    int n = size();
+    regions.resize(n * n);
+    for (int cell = 0; cell < n * n; ++cell)
+        regions[cell] = (cell / n) / box * box + (cell % n) / box;
+    compile();
+}
+
+void SudokuUnits::addDiagonals()
+{
+    diagonals = true;
+    compile();
+}
+
+bool SudokuUnits::setRegions(const std::vector<uint8_t> &regionOf)
+{
+    int n = size();
+    if (static_cast<int>(regionOf.size()) != n * n) return false;
+    std::vector<int> counts(n, 0);
+    for (uint8_t region : regionOf) {
+        if (region >= n || ++counts[region] > n) return false;
+    }
+    regions = regionOf;
+    jigsaw = true;
+    compile();
+    return true;
+}
+
+bool SudokuUnits::addCage(const std::vector<int> &cells, int sum)
+{
+    int n = size();
+    int count = static_cast<int>(cells.size());
+    if (count == 0 || count > n) return false;
+    // Smallest and largest totals of count distinct digits
+    int least = count * (count + 1) / 2;
+    int most = count * (2 * n - count + 1) / 2;
+    if (sum < least || sum > most) return false;
+
+    std::vector<uint8_t> seen(n * n, 0);
+    Cage cage;
+    for (int cell : cells) {
+        if (cell < 0 || cell >= n * n || seen[cell] || cageUnit[cell] >= 0) return false;
+        seen[cell] = 1;
+        cage.cells.push_back(cell);
+    }
+    cage.sum = sum;
+    cageList.push_back(cage);
+    compile();
+    return true;
+}
+
+void SudokuUnits::addUnit(Kind kind, const std::vector<uint16_t> &cells, int sum)
+{
+    units.push_back({kind, static_cast<uint16_t>(sum), static_cast<uint32_t>(unitCells.size()),
+                     static_cast<uint32_t>(cells.size())});
+    unitCells.insert(unitCells.end(), cells.begin(), cells.end());
+}
+
+void SudokuUnits::compile()
+{
+    int n = size();
+    int cellTotal = n * n;
+    units.clear();
+    unitCells.clear();
+
+    // Rows, then columns, then boxes or regions, as the classic tables order them
+    std::vector<uint16_t> cells(n);
+    for (int r = 0; r < n; ++r) {
+        for (int k = 0; k < n; ++k) cells[k] = r * n + k;
+        addUnit(Kind::Row, cells);
+    }
+    for (int c = 0; c < n; ++c) {
+        for (int k = 0; k < n; ++k) cells[k] = k * n + c;
+        addUnit(Kind::Column, cells);
+    }
+    std::vector<std::vector<uint16_t>> members(n);
+    for (int cell = 0; cell < cellTotal; ++cell)
+        members[regions[cell]].push_back(cell);
+    for (const std::vector<uint16_t> &region : members)
+        addUnit(jigsaw ? Kind::Region : Kind::Box, region);
+    if (diagonals) {
+        for (int k = 0; k < n; ++k) cells[k] = k * n + k;
+        addUnit(Kind::Diagonal, cells);
+        for (int k = 0; k < n; ++k) cells[k] = k * n + n - 1 - k;
+        addUnit(Kind::Diagonal, cells);
+    }
+    cageUnit.assign(cellTotal, -1);
+    for (const Cage &cage : cageList) {
+        for (int cell : cage.cells)
+            cageUnit[cell] = unitCount();
+        addUnit(Kind::Cage, cage.cells, cage.sum);
+    }
+
+    // Per-cell unit lists: count, prefix-sum, fill
+    cellUnitStart.assign(cellTotal + 1, 0);
+    for (int unit = 0; unit < unitCount(); ++unit) {
+        for (uint16_t cell : this->cells(unit))
+            ++cellUnitStart[cell + 1];
+    }
+    for (int cell = 0; cell < cellTotal; ++cell)
+        cellUnitStart[cell + 1] += cellUnitStart[cell];
+    cellUnits.resize(cellUnitStart[cellTotal]);
+    std::vector<uint32_t> next(cellUnitStart.begin(), cellUnitStart.end() - 1);
+    for (int unit = 0; unit < unitCount(); ++unit) {
+        for (uint16_t cell : this->cells(unit))
+            cellUnits[next[cell]++] = unit;
+    }
+
+    // Peers, each listed once however many units a pair shares
+    peerStart.assign(cellTotal + 1, 0);
+    peers.clear();
+    std::vector<int> stamp(cellTotal, -1);
+    for (int cell = 0; cell < cellTotal; ++cell) {
+        stamp[cell] = cell;
+        for (uint16_t unit : unitsOf(cell)) {
+            for (uint16_t peer : this->cells(unit)) {
+                if (stamp[peer] == cell) continue;
+                stamp[peer] = cell;
+                peers.push_back(peer);
+            }
+        }
+        peerStart[cell + 1] = peers.size();
+    }
+}
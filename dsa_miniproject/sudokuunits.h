@@ -0,0 +1,95 @@
+#ifndef SUDOKUUNITS_H
+#define SUDOKUUNITS_H
+
+#include <cstdint>
+#include <vector>
+
+// The constraint units of a Sudoku variant, compiled into flat tables.
+// A unit is a group of cells whose digits must all differ: rows, columns and
+// boxes for the classic game, the two long diagonals for X-Sudoku, irregular
+// regions in place of the boxes for Jigsaw and cages for Killer, which also
+// fix the sum of their digits. Every change recompiles the per-cell unit
+// lists and a deduplicated per-cell peer list into contiguous arrays, so the
+// model and the variant engine check a cell with one linear scan whatever
+// the variant.
+class SudokuUnits
+{
+public:
+    enum class Kind : uint8_t { Row, Column, Box, Diagonal, Region, Cage };
+
+    // A run of indices inside one of the flat tables
+    struct Span {
+        const uint16_t *first;
+        const uint16_t *last;
+        const uint16_t *begin() const { return first; }
+        const uint16_t *end() const { return last; }
+        int size() const { return static_cast<int>(last - first); }
+    };
+
+    // Classic rows, columns and boxes of a Box² x Box² board
+    explicit SudokuUnits(int box = 3);
+
+    // X-Sudoku: both long diagonals hold every digit once
+    void addDiagonals();
+
+    // Jigsaw: regionOf[cell] replaces the boxes. False (and no change)
+    // unless there are Size regions of Size cells each.
+    bool setRegions(const std::vector<uint8_t> &regionOf);
+
+    // Killer: distinct digits adding up to sum. False if a cell is out of
+    // range, repeated or already caged, or the sum cannot be reached.
+    bool addCage(const std::vector<int> &cells, int sum);
+
+    bool isClassic() const { return !diagonals && !jigsaw && cageList.empty(); }
+    bool hasDiagonals() const { return diagonals; }
+    bool hasRegions() const { return jigsaw; }
+    bool hasCages() const { return !cageList.empty(); }
+    int boxSize() const { return box; }
+    int size() const { return box * box; }
+    int cellCount() const { return size() * size(); }
+    int unitCount() const { return static_cast<int>(units.size()); }
+
+    Kind kind(int unit) const { return units[unit].kind; }
+    int sum(int unit) const { return units[unit].sum; }   // 0 unless a cage
+    Span cells(int unit) const { return span(unitCells, units[unit].first, units[unit].first + units[unit].count); }
+    Span unitsOf(int cell) const { return span(cellUnits, cellUnitStart[cell], cellUnitStart[cell + 1]); }
+    Span peersOf(int cell) const { return span(peers, peerStart[cell], peerStart[cell + 1]); }
+    int regionOf(int cell) const { return regions[cell]; }   // box or jigsaw region
+    int cageOf(int cell) const { return cageUnit[cell]; }     // unit index, -1 if uncaged
+
+private:
+    struct Unit {
+        Kind kind;
+        uint16_t sum;
+        uint32_t first;   // offset into unitCells
+        uint32_t count;
+    };
+    struct Cage {
+        std::vector<uint16_t> cells;
+        int sum;
+    };
+
+    int box;
+    bool diagonals;
+    bool jigsaw;
+    std::vector<uint8_t> regions;
+    std::vector<Cage> cageList;
+
+    // Compiled tables
+    std::vector<Unit> units;
+    std::vector<uint16_t> unitCells;
+    std::vector<uint32_t> cellUnitStart;   // CellCount + 1 offsets into cellUnits
+    std::vector<uint16_t> cellUnits;
+    std::vector<uint32_t> peerStart;       // CellCount + 1 offsets into peers
+    std::vector<uint16_t> peers;
+    std::vector<int> cageUnit;
+
+    static Span span(const std::vector<uint16_t> &table, uint32_t first, uint32_t last)
+    {
+        return {table.data() + first, table.data() + last};
+    }
+    void addUnit(Kind kind, const std::vector<uint16_t> &cells, int sum = 0);
+    void compile();
+};
+
+#endif // SUDOKUUNITS_H
@@ -0,0 +1,274 @@
+#include "sudokuvariantengine.h"
+#include <algorithm>
+
+namespace {
+
+inline int lowestDigit(uint32_t mask) { return __builtin_ctz(mask) + 1; }
+inline bool isSingle(uint32_t mask) { return (mask & (mask - 1)) == 0; }
+inline int bitCount(uint32_t mask) { return __builtin_popcount(mask); }
+
+} // namespace
+
+SudokuVariantEngine::SudokuVariantEngine()
+{
+    units = nullptr;
+    changeSink = nullptr;
+    all = 0;
+    filled = 0;
+    consistent = false;
+    solved = false;
+    gaveUp = false;
+    nodeLimit = 0;
+    counters = {0, 0, 0, 0};
+}
+
+bool SudokuVariantEngine::load(const SudokuUnits &units, const std::vector<uint8_t> &givens)
+{
+    this->units = &units;
+    int n = units.size();
+    all = (1u << n) - 1;
+    cells.assign(units.cellCount(), 0);
+    masks.assign(units.cellCount(), 0);
+    unitUsed.assign(units.unitCount(), 0);
+    unitSum.assign(units.unitCount(), 0);
+    unitEmpty.assign(units.unitCount(), 0);
+    for (int unit = 0; unit < units.unitCount(); ++unit)
+        unitEmpty[unit] = units.cells(unit).size();
+    trail.clear();
+    frames.clear();
+    changeSink = nullptr;
+    filled = 0;
+    solved = false;
+    counters = {0, 0, 0, 0};
+
+    consistent = true;
+    for (int cell = 0; cell < units.cellCount() && consistent; ++cell) {
+        int value = givens[cell];
+        if (value == 0) continue;
+        consistent = value <= n && assign(cell, value);
+    }
+    trail.clear();   // givens are never undone
+    return consistent;
+}
+
+SudokuVariantEngine::Status SudokuVariantEngine::solve()
+{
+    changeSink = nullptr;
+    return search(1) ? Status::Solved : Status::Unsolvable;
+}
+
+SudokuVariantEngine::Status SudokuVariantEngine::solve(std::vector<SudokuChange> &trace)
+{
+    changeSink = &trace;
+    Status status = search(1) ? Status::Solved : Status::Unsolvable;
+    changeSink = nullptr;
+    return status;
+}
+
+int SudokuVariantEngine::countSolutions(int limit)
+{
+    changeSink = nullptr;
+    return search(limit);
+}
+
+uint32_t SudokuVariantEngine::cageCandidates(int unit, uint32_t mask) const
+{
+    // The other empty cells need distinct unused digits adding up to the rest
+    int others = unitEmpty[unit] - 1;
+    int rest = units->sum(unit) - unitSum[unit];
+    uint32_t free = all & ~unitUsed[unit];
+    uint32_t result = 0;
+    for (uint32_t m = mask; m; m &= m - 1) {
+        int digit = lowestDigit(m);
+        uint32_t pool = free & ~(1u << (digit - 1));
+        int need = rest - digit;
+        if (others == 0) {
+            if (need == 0) result |= 1u << (digit - 1);
+            continue;
+        }
+        if (bitCount(pool) < others) continue;
+        int least = 0, most = 0;
+        uint32_t low = pool, high = pool;
+        for (int k = 0; k < others; ++k) {
+            least += lowestDigit(low);
+            low &= low - 1;
+            int top = 32 - __builtin_clz(high);
+            most += top;
+            high &= ~(1u << (top - 1));
+        }
+        if (least <= need && need <= most) result |= 1u << (digit - 1);
+    }
+    return result;
+}
+
+uint32_t SudokuVariantEngine::candidates(int cell) const
+{
+    uint32_t used = 0;
+    for (uint16_t unit : units->unitsOf(cell))
+        used |= unitUsed[unit];
+    uint32_t mask = all & ~used;
+    int cage = units->cageOf(cell);
+    return cage >= 0 && mask ? cageCandidates(cage, mask) : mask;
+}
+
+bool SudokuVariantEngine::assign(int cell, int value)
+{
+    if (cells[cell] != 0) return cells[cell] == value;
+    uint32_t bit = 1u << (value - 1);
+    if (!(candidates(cell) & bit)) return false;
+
+    cells[cell] = value;
+    for (uint16_t unit : units->unitsOf(cell)) {
+        unitUsed[unit] |= bit;
+        unitSum[unit] += value;
+        --unitEmpty[unit];
+    }
+    trail.push_back(cell);
+    ++filled;
+    if (changeSink)
+        changeSink->push_back({static_cast<uint16_t>(cell), static_cast<uint16_t>(value)});
+    return true;
+}
+
+void SudokuVariantEngine::undoTo(uint32_t mark)
+{
+    while (trail.size() > mark) {
+        int cell = trail.back();
+        trail.pop_back();
+        int value = cells[cell];
+        for (uint16_t unit : units->unitsOf(cell)) {
+            unitUsed[unit] &= ~(1u << (value - 1));
+            unitSum[unit] -= value;
+            ++unitEmpty[unit];
+        }
+        cells[cell] = 0;
+        --filled;
+        if (changeSink)
+            changeSink->push_back({static_cast<uint16_t>(cell), 0});
+    }
+}
+
+bool SudokuVariantEngine::propagate()
+{
+    // As in BasicSudokuEngine, the hidden singles pass reads the masks the
+    // naked singles pass computed. Later placements only shrink the real
+    // candidates, so a stale mask can hide a single but never invent one.
+    int cellTotal = units->cellCount();
+    int n = units->size();
+    bool progress = true;
+    while (progress && filled < cellTotal) {
+        progress = false;
+        ++counters.rounds;
+
+        // Naked singles
+        for (int cell = 0; cell < cellTotal; ++cell) {
+            if (cells[cell]) continue;
+            uint32_t cand = candidates(cell);
+            if (!cand) return false;
+            masks[cell] = cand;
+            if (isSingle(cand)) {
+                assign(cell, lowestDigit(cand));
+                progress = true;
+            }
+        }
+
+        // Hidden singles, in units that must hold every digit
+        for (int unit = 0; unit < units->unitCount(); ++unit) {
+            SudokuUnits::Span members = units->cells(unit);
+            if (members.size() != n) continue;
+            uint32_t used = unitUsed[unit], once = 0, twice = 0;
+            for (uint16_t cell : members) {
+                if (cells[cell]) continue;
+                twice |= once & masks[cell];
+                once |= masks[cell];
+            }
+            if ((used | once) != all) return false;   // some digit has nowhere to go
+            for (uint32_t hidden = once & ~twice & ~used; hidden; hidden &= hidden - 1) {
+                int value = lowestDigit(hidden);
+                for (uint16_t cell : members) {
+                    if (cells[cell] == 0 && (masks[cell] & (1u << (value - 1)))) {
+                        if (!assign(cell, value)) return false;   // a placement above took its last spot
+                        progress = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+int SudokuVariantEngine::pickCell(uint32_t &cand) const
+{
+    int best = -1;
+    int bestCount = 33;
+    for (int cell = 0; cell < units->cellCount(); ++cell) {
+        if (cells[cell]) continue;
+        uint32_t mask = candidates(cell);
+        int count = bitCount(mask);
+        if (count < bestCount) {
+            best = cell;
+            bestCount = count;
+            cand = mask;
+            if (count <= 1) break;
+        }
+    }
+    return best;
+}
+
+int SudokuVariantEngine::search(int limit)
+{
+    int solutions = 0;
+    gaveUp = false;
+    if (!consistent) return 0;
+    uint64_t stopAt = nodeLimit ? counters.nodes + nodeLimit : 0;
+    bool ok = propagate();
+
+    auto found = [&]() {
+        if (solutions++ == 0) solution = cells;
+    };
+    auto branch = [&]() {
+        Frame frame;
+        uint32_t cand = 0;
+        frame.cell = pickCell(cand);
+        frame.remaining = cand;
+        frame.trailMark = trail.size();
+        frames.push_back(frame);
+        counters.maxDepth = std::max<uint32_t>(counters.maxDepth, frames.size());
+    };
+
+    if (ok && filled == units->cellCount()) found();
+    else if (ok) branch();
+
+    while (!frames.empty() && solutions < limit) {
+        Frame &top = frames.back();
+        undoTo(top.trailMark);
+        if (!top.remaining) {
+            frames.pop_back();
+            continue;
+        }
+        if (stopAt && counters.nodes >= stopAt) {
+            gaveUp = true;
+            break;
+        }
+        int value = lowestDigit(top.remaining);
+        top.remaining &= top.remaining - 1;
+        ++counters.nodes;
+        if (assign(top.cell, value) && propagate()) {
+            if (filled == units->cellCount()) found();
+            else branch();
+        } else {
+            ++counters.backtracks;
+        }
+    }
+
+    // Back to the givens, so the engine can be asked again; the trace
+    // ends on the solution, so the rewind is not recorded
+    std::vector<SudokuChange> *sink = changeSink;
+    changeSink = nullptr;
+    frames.clear();
+    undoTo(0);
+    changeSink = sink;
+    solved = solutions > 0;
+    return solutions;
+}
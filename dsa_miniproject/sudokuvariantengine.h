@@ -0,0 +1,78 @@
+#ifndef SUDOKUVARIANTENGINE_H
+#define SUDOKUVARIANTENGINE_H
+
+#include <cstdint>
+#include <vector>
+#include "sudokuengine.h"
+#include "sudokuunits.h"
+
+// Constraint-propagation solver for any SudokuUnits variant. It works like
+// BasicSudokuEngine: a used-digit mask per unit, naked and hidden singles
+// after every placement, branching on the most constrained cell, and an
+// explicit guess stack. Candidates are found by walking the cell's compiled
+// unit list rather than a fixed row/column/box triple. Killer cages also keep
+// a running sum; a digit survives only if the cage's other empty cells can
+// still make up the rest with distinct unused digits.
+class SudokuVariantEngine
+{
+public:
+    using Stats = SudokuEngine::Stats;
+
+    enum class Status { Solved, Unsolvable };
+
+    SudokuVariantEngine();
+
+    // units must outlive the engine. Returns false if the givens already
+    // break a unit.
+    bool load(const SudokuUnits &units, const std::vector<uint8_t> &givens);
+
+    Status solve();
+    Status solve(std::vector<SudokuChange> &trace);   // records placements and clears
+
+    // Stops as soon as limit is reached; grid() holds the first solution
+    int countSolutions(int limit = 2);
+
+    // Caps the guesses of each solve or count, 0 for none. A search that
+    // hits the cap stops early and reports abandoned(); the generator uses
+    // this to drop layouts whose proof of no solution would take too long.
+    void setNodeLimit(uint64_t limit) { nodeLimit = limit; }
+    bool abandoned() const { return gaveUp; }
+
+    const std::vector<uint8_t> &grid() const { return solved ? solution : cells; }
+    const Stats &stats() const { return counters; }
+
+private:
+    struct Frame {
+        uint16_t cell;
+        uint32_t remaining;   // candidates not tried yet
+        uint32_t trailMark;   // trail size before the guess
+    };
+
+    const SudokuUnits *units;
+    std::vector<uint8_t> cells;
+    std::vector<uint8_t> solution;
+    std::vector<uint32_t> masks;       // candidates from the last naked singles pass
+    std::vector<uint32_t> unitUsed;
+    std::vector<uint16_t> unitSum;     // total of the digits placed; read for cages
+    std::vector<uint16_t> unitEmpty;   // empty cells left; read for cages
+    std::vector<uint16_t> trail;
+    std::vector<Frame> frames;
+    std::vector<SudokuChange> *changeSink;
+    uint32_t all;
+    int filled;
+    bool consistent;   // givens loaded without a clash
+    bool solved;
+    bool gaveUp;
+    uint64_t nodeLimit;
+    Stats counters;
+
+    uint32_t candidates(int cell) const;
+    uint32_t cageCandidates(int unit, uint32_t mask) const;
+    bool assign(int cell, int value);
+    void undoTo(uint32_t mark);
+    bool propagate();
+    int pickCell(uint32_t &cand) const;
+    int search(int limit);
+};
+
+#endif // SUDOKUVARIANTENGINE_H
@@ -0,0 +1,377 @@
+#include "sudokuvariants.h"
+#include "sudokuvariantengine.h"
+#include <sstream>
+#include <utility>
+
+namespace {
+
+using Rules = SudokuVariants::Rules;
+
+const int Size = 9;
+const int CellCount = 81;
+
+// Clues left when digging stops early; 0 digs to a minimal puzzle. Cages
+// carry most of a Killer's information, so it keeps far fewer digits.
+int clueTarget(Rules rules, SudokuGenerator::Difficulty difficulty)
+{
+    bool killer = rules == Rules::Killer;
+    switch (difficulty) {
+    case SudokuGenerator::Difficulty::Easy: return killer ? 20 : 36;
+    case SudokuGenerator::Difficulty::Medium: return killer ? 8 : 28;
+    case SudokuGenerator::Difficulty::Hard: return 0;
+    }
+    return 0;
+}
+
+void shuffle(std::vector<int> &values, SudokuRandom &random)
+{
+    for (int i = static_cast<int>(values.size()) - 1; i > 0; --i)
+        std::swap(values[i], values[random.bounded(i + 1)]);
+}
+
+// Orthogonal neighbours of a cell, -1 past the edge
+void neighbours(int cell, int out[4])
+{
+    int r = cell / Size, c = cell % Size;
+    out[0] = r > 0 ? cell - Size : -1;
+    out[1] = r < Size - 1 ? cell + Size : -1;
+    out[2] = c > 0 ? cell - 1 : -1;
+    out[3] = c < Size - 1 ? cell + 1 : -1;
+}
+
+bool connected(const std::vector<uint8_t> &regions, int region)
+{
+    int start = -1, members = 0;
+    for (int cell = 0; cell < CellCount; ++cell) {
+        if (regions[cell] != region) continue;
+        if (start < 0) start = cell;
+        ++members;
+    }
+    std::vector<uint8_t> seen(CellCount, 0);
+    std::vector<int> queue = {start};
+    seen[start] = 1;
+    for (size_t next = 0; next < queue.size(); ++next) {
+        int around[4];
+        neighbours(queue[next], around);
+        for (int n : around) {
+            if (n < 0 || seen[n] || regions[n] != region) continue;
+            seen[n] = 1;
+            queue.push_back(n);
+        }
+    }
+    return static_cast<int>(queue.size()) == members;
+}
+
+// Boxes reshaped by trading a border cell each way between two neighbouring
+// regions, kept only while both remain connected
+std::vector<uint8_t> jigsawRegions(SudokuRandom &random)
+{
+    std::vector<uint8_t> regions(CellCount);
+    for (int cell = 0; cell < CellCount; ++cell)
+        regions[cell] = (cell / Size) / 3 * 3 + (cell % Size) / 3;
+
+    int swaps = 0;
+    for (int tries = 0; swaps < 120 && tries < 20000; ++tries) {
+        int a = random.bounded(CellCount);
+        int around[4];
+        neighbours(a, around);
+        int b = around[random.bounded(4)];
+        if (b < 0 || regions[b] == regions[a]) continue;
+        int from = regions[a], to = regions[b];
+
+        // a joins its neighbour's region; a cell of that region touching
+        // a's old region goes the other way
+        regions[a] = to;
+        std::vector<int> candidates;
+        for (int cell = 0; cell < CellCount; ++cell) {
+            if (regions[cell] != to || cell == a) continue;
+            neighbours(cell, around);
+            for (int n : around) {
+                if (n >= 0 && regions[n] == from) {
+                    candidates.push_back(cell);
+                    break;
+                }
+            }
+        }
+        if (candidates.empty()) {
+            regions[a] = from;
+            continue;
+        }
+        int c = candidates[random.bounded(static_cast<int>(candidates.size()))];
+        regions[c] = from;
+        if (connected(regions, from) && connected(regions, to)) {
+            ++swaps;
+        } else {
+            regions[a] = from;
+            regions[c] = to;
+        }
+    }
+    return regions;
+}
+
+// Guesses allowed per solve. A Jigsaw layout, or random seed digits on one,
+// can leave a board with no solution whose proof runs for seconds; those are
+// dropped at the cap. The cap sits far above what a solvable board needs.
+const uint64_t NodeLimit = 20000;
+
+// Random Jigsaw layouts tried before FallbackRegions, which is known to admit
+// a grid, so generation always ends
+const int LayoutAttempts = 4;
+const char FallbackRegions[] =
+    "112222333112122236411123336444155366444555366445585669777785869778888899777899999";
+
+std::vector<uint8_t> fallbackRegions()
+{
+    std::vector<uint8_t> regions(CellCount);
+    for (int cell = 0; cell < CellCount; ++cell)
+        regions[cell] = static_cast<uint8_t>(FallbackRegions[cell] - '1');
+    return regions;
+}
+
+// A solved grid under units. Solving the empty board first proves the layout
+// admits a grid at all; a few random digits then steer towards a less regular
+// one, and if they all contradict, the first grid is used with its digits
+// relabelled. Returns false only if the empty board finds no grid.
+bool fillGrid(const SudokuUnits &units, SudokuRandom &random, std::vector<uint8_t> &grid)
+{
+    SudokuVariantEngine engine;
+    engine.setNodeLimit(NodeLimit);
+    engine.load(units, std::vector<uint8_t>(CellCount, 0));
+    if (engine.solve() != SudokuVariantEngine::Status::Solved) return false;
+    std::vector<uint8_t> first = engine.grid();
+
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        std::vector<uint8_t> seeds(CellCount, 0);
+        for (int k = 0; k < 11; ++k) {
+            int cell = random.bounded(CellCount);
+            seeds[cell] = static_cast<uint8_t>(1 + random.bounded(Size));
+            if (!engine.load(units, seeds))
+                seeds[cell] = 0;
+        }
+        engine.load(units, seeds);
+        if (engine.solve() == SudokuVariantEngine::Status::Solved) {
+            grid = engine.grid();
+            return true;
+        }
+    }
+    std::vector<int> digits = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    shuffle(digits, random);
+    grid.resize(CellCount);
+    for (int cell = 0; cell < CellCount; ++cell)
+        grid[cell] = static_cast<uint8_t>(digits[first[cell] - 1]);
+    return true;
+}
+
+// Cages of two to four cells grown from random starts over the solution,
+// never repeating a digit; a cell with nowhere to grow stays a single
+void addCages(SudokuUnits &units, const std::vector<uint8_t> &solution, SudokuRandom &random)
+{
+    const int sizes[] = {2, 2, 3, 3, 3, 4};
+    std::vector<int> order(CellCount);
+    for (int i = 0; i < CellCount; ++i)
+        order[i] = i;
+    shuffle(order, random);
+
+    std::vector<uint8_t> caged(CellCount, 0);
+    for (int start : order) {
+        if (caged[start]) continue;
+        int target = sizes[random.bounded(6)];
+        std::vector<int> cage = {start};
+        uint32_t digits = 1u << solution[start];
+        caged[start] = 1;
+        while (static_cast<int>(cage.size()) < target) {
+            std::vector<int> frontier;
+            for (int cell : cage) {
+                int around[4];
+                neighbours(cell, around);
+                for (int n : around) {
+                    if (n >= 0 && !caged[n] && !(digits >> solution[n] & 1))
+                        frontier.push_back(n);
+                }
+            }
+            if (frontier.empty()) break;
+            int next = frontier[random.bounded(static_cast<int>(frontier.size()))];
+            cage.push_back(next);
+            digits |= 1u << solution[next];
+            caged[next] = 1;
+        }
+        int sum = 0;
+        for (int cell : cage)
+            sum += solution[cell];
+        units.addCage(cage, sum);
+    }
+}
+
+} // namespace
+
+SudokuVariants::Puzzle SudokuVariants::generate(Rules rules, uint64_t seed, SudokuGenerator::Difficulty difficulty)
+{
+    SudokuRandom random(seed);
+    Puzzle puzzle;
+    puzzle.rules = rules;
+    puzzle.seed = seed;
+
+    std::vector<uint8_t> solution;
+    for (int layout = 0;; ++layout) {
+        puzzle.units = SudokuUnits(3);
+        if (rules == Rules::X)
+            puzzle.units.addDiagonals();
+        else if (rules == Rules::Jigsaw)
+            puzzle.units.setRegions(layout < LayoutAttempts ? jigsawRegions(random) : fallbackRegions());
+        // A jigsaw layout can admit no grid at all; draw another. Every
+        // other unit set, the fallback layout included, fills first time.
+        if (fillGrid(puzzle.units, random, solution)) break;
+    }
+    if (rules == Rules::Killer)
+        addCages(puzzle.units, solution, random);
+
+    // Dig in random order while the solution stays unique
+    puzzle.givens = solution;
+    std::vector<int> order(CellCount);
+    for (int i = 0; i < CellCount; ++i)
+        order[i] = i;
+    shuffle(order, random);
+    SudokuVariantEngine engine;
+    engine.setNodeLimit(NodeLimit);
+    int clues = CellCount, target = clueTarget(rules, difficulty);
+    for (int i = 0; i < CellCount && clues > target; ++i) {
+        int cell = order[i];
+        uint8_t value = puzzle.givens[cell];
+        puzzle.givens[cell] = 0;
+        // A count cut short proves nothing, so that clue stays
+        if (engine.load(puzzle.units, puzzle.givens) && engine.countSolutions(2) == 1 && !engine.abandoned())
+            --clues;
+        else
+            puzzle.givens[cell] = value;
+    }
+    return puzzle;
+}
+
+SudokuVariants::Rules SudokuVariants::rulesOf(const SudokuUnits &units)
+{
+    if (units.hasCages()) return Rules::Killer;
+    if (units.hasRegions()) return Rules::Jigsaw;
+    if (units.hasDiagonals()) return Rules::X;
+    return Rules::Classic;
+}
+
+const char *SudokuVariants::name(Rules rules)
+{
+    switch (rules) {
+    case Rules::Classic: return "Classic";
+    case Rules::X: return "X-Sudoku";
+    case Rules::Jigsaw: return "Jigsaw";
+    case Rules::Killer: return "Killer";
+    }
+    return "Classic";
+}
+
+std::string SudokuVariants::rulesText(const SudokuUnits &units)
+{
+    std::ostringstream out;
+    switch (rulesOf(units)) {
+    case Rules::Classic:
+        out << "classic";
+        break;
+    case Rules::X:
+        out << "x";
+        break;
+    case Rules::Jigsaw:
+        out << "jigsaw ";
+        for (int cell = 0; cell < units.cellCount(); ++cell)
+            out << char('1' + units.regionOf(cell));
+        break;
+    case Rules::Killer:
+        out << "killer";
+        for (int unit = 0; unit < units.unitCount(); ++unit) {
+            if (units.kind(unit) != SudokuUnits::Kind::Cage) continue;
+            out << ' ' << units.sum(unit);
+            char separator = ':';
+            for (uint16_t cell : units.cells(unit)) {
+                out << separator << cell;
+                separator = ',';
+            }
+        }
+        break;
+    }
+    return out.str();
+}
+
+bool SudokuVariants::parseRules(const std::string &text, SudokuUnits &units)
+{
+    std::istringstream in(text);
+    std::string keyword;
+    SudokuUnits parsed(3);
+    if (!(in >> keyword) || keyword == "classic") {
+        units = parsed;
+        return true;
+    }
+
+    if (keyword == "x") {
+        parsed.addDiagonals();
+    } else if (keyword == "jigsaw") {
+        std::string digits;
+        if (!(in >> digits) || static_cast<int>(digits.size()) != CellCount) return false;
+        std::vector<uint8_t> regions(CellCount);
+        for (int cell = 0; cell < CellCount; ++cell) {
+            if (digits[cell] < '1' || digits[cell] > '9') return false;
+            regions[cell] = static_cast<uint8_t>(digits[cell] - '1');
+        }
+        if (!parsed.setRegions(regions)) return false;
+    } else if (keyword == "killer") {
+        std::string token;
+        while (in >> token) {
+            // sum:cell,cell,...
+            size_t colon = token.find(':');
+            if (colon == std::string::npos) return false;
+            std::vector<int> cells;
+            int sum = 0;
+            try {
+                sum = std::stoi(token.substr(0, colon));
+                std::istringstream list(token.substr(colon + 1));
+                std::string cell;
+                while (std::getline(list, cell, ','))
+                    cells.push_back(std::stoi(cell));
+            } catch (...) {
+                return false;
+            }
+            if (!parsed.addCage(cells, sum)) return false;
+        }
+    } else {
+        return false;
+    }
+    units = parsed;
+    return true;
+}
+
+std::string SudokuVariants::format(const Puzzle &puzzle)
+{
+    std::string line;
+    for (uint8_t value : puzzle.givens)
+        line += char('0' + value);
+    return line + ' ' + rulesText(puzzle.units);
+}
+
+bool SudokuVariants::parse(const std::string &line, Puzzle &puzzle)
+{
+    std::istringstream in(line);
+    std::string digits;
+    if (!(in >> digits) || static_cast<int>(digits.size()) != CellCount) return false;
+    std::vector<uint8_t> givens(CellCount);
+    for (int cell = 0; cell < CellCount; ++cell) {
+        char ch = digits[cell];
+        if (ch == '.' || ch == '0') givens[cell] = 0;
+        else if (ch >= '1' && ch <= '9') givens[cell] = static_cast<uint8_t>(ch - '0');
+        else return false;
+    }
+    std::string rest;
+    std::getline(in, rest);
+    SudokuUnits units(3);
+    if (!parseRules(rest, units)) return false;
+
+    puzzle.units = units;
+    puzzle.rules = rulesOf(units);
+    puzzle.givens = givens;
+    puzzle.seed = 0;
+    return true;
+}
@@ -0,0 +1,53 @@
+#ifndef SUDOKUVARIANTS_H
+#define SUDOKUVARIANTS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "sudokugenerator.h"
+#include "sudokuunits.h"
+
+// 9x9 puzzles for the variant rules and their one-line text form.
+//
+// The generator fills a grid under the variant's own units (X-Sudoku and
+// Jigsaw) or the classic ones (Killer, whose cages are then cut from the
+// solution), and digs clues in random order while SudokuVariantEngine still
+// counts exactly one solution. Jigsaw regions start as the boxes and are
+// reshaped by swapping border cells between neighbouring regions while both
+// stay connected.
+//
+// Text form, as read by the benchmark corpora and stored in sessions: the 81
+// givens (0 or '.' for empty) followed by the rules,
+//   x                                both long diagonals
+//   jigsaw <81 region digits 1-9>    row-major region of each cell
+//   killer <sum:cell,cell,...> ...   one token per cage, cells row-major 0-80
+// and nothing, or "classic", for the ordinary game.
+class SudokuVariants
+{
+public:
+    enum class Rules { Classic, X, Jigsaw, Killer };
+
+    struct Puzzle {
+        Rules rules;
+        SudokuUnits units;
+        std::vector<uint8_t> givens;   // 81, 0 for empty
+        uint64_t seed;
+    };
+
+    // Same seed, rules and difficulty always give the same puzzle
+    static Puzzle generate(Rules rules, uint64_t seed, SudokuGenerator::Difficulty difficulty);
+
+    static Rules rulesOf(const SudokuUnits &units);
+    static const char *name(Rules rules);
+
+    // The rules part of the text form, and back. parseRules leaves units
+    // untouched and returns false on anything malformed or inconsistent.
+    static std::string rulesText(const SudokuUnits &units);
+    static bool parseRules(const std::string &text, SudokuUnits &units);
+
+    // A whole puzzle line: givens, a space, then rulesText
+    static std::string format(const Puzzle &puzzle);
+    static bool parse(const std::string &line, Puzzle &puzzle);
+};
+
+#endif // SUDOKUVARIANTS_H